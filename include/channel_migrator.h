@@ -0,0 +1,66 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Interference-triggered channel migration: decides when the active channel
+// has degraded enough, for long enough, to move to a quieter candidate.
+// Pure C (no ESP-IDF, no clock of its own): fed by the radio TX task, and
+// replayable on a host against recorded occupancy/success traces
+
+// Defaults. The active channel is degraded while its decayed occupancy is at
+// or above BUSY_PCT, or windowed TX success is below SUCCESS_PCT
+#define CHANNEL_MIGRATE_BUSY_PCT 35
+#define CHANNEL_MIGRATE_SUCCESS_PCT 80
+// Hysteresis: the target must be at least this many points quieter, and
+// the degradation must last HOLD_MS without a break
+#define CHANNEL_MIGRATE_MARGIN_PCT 20
+#define CHANNEL_MIGRATE_HOLD_MS 5000
+// Rate limit: no migration sooner than this after any channel change
+// (manual picks included)
+#define CHANNEL_MIGRATE_MIN_INTERVAL_MS 60000
+
+typedef struct {
+  uint8_t busy_pct;    // degraded at or above
+  uint8_t success_pct; // degraded below
+  uint8_t margin_pct;
+  uint32_t hold_ms;
+  uint32_t min_interval_ms;
+} ChannelMigratorConfig;
+
+#define CHANNEL_MIGRATOR_CONFIG_DEFAULT                                      \
+  ((ChannelMigratorConfig){.busy_pct = CHANNEL_MIGRATE_BUSY_PCT,             \
+                           .success_pct = CHANNEL_MIGRATE_SUCCESS_PCT,       \
+                           .margin_pct = CHANNEL_MIGRATE_MARGIN_PCT,         \
+                           .hold_ms = CHANNEL_MIGRATE_HOLD_MS,               \
+                           .min_interval_ms = CHANNEL_MIGRATE_MIN_INTERVAL_MS})
+
+// One observation. busy_pct is indexed like the candidate list
+typedef struct {
+  const uint8_t *busy_pct;
+  uint8_t count;
+  uint8_t active_idx;
+  int16_t success_pct; // -1 = no ticks in the window
+} ChannelMigratorInput;
+
+typedef struct {
+  ChannelMigratorConfig cfg;
+  bool degraded;
+  uint32_t degraded_since_ms;
+  bool changed; // last_change_ms is valid
+  uint32_t last_change_ms;
+  uint16_t migrations;
+} ChannelMigrator;
+
+// cfg NULL = defaults
+void channel_migrator_init(ChannelMigrator *m,
+                           const ChannelMigratorConfig *cfg);
+
+// Any channel change (manual or migration) restarts the rate limit and the
+// degradation hold
+void channel_migrator_note_change(ChannelMigrator *m, uint32_t now_ms);
+
+// Feed one observation. Returns the candidate index to migrate to, or -1.
+// A returned index counts as a change (no need to call note_change)
+int channel_migrator_step(ChannelMigrator *m, const ChannelMigratorInput *in,
+                          uint32_t now_ms);
@@ -28,6 +28,51 @@ typedef enum {
   COLOR_SCHEME_CUSTOM      // Default orange behavior
 } color_scheme_t;
 
+#define COLOR_SCHEME_COUNT (COLOR_SCHEME_CUSTOM + 1)
+
+// Seconds remaining below which a scheme switches to its urgent color
+#define URGENT_COUNTDOWN_THRESHOLD_SEC 5
+
+// TX brightness profiles (percent), cycled by rotary click on the running
+// screen and applied to the RGB carried in the radio frame
+#define COLOR_BRIGHTNESS_LEVELS 3
+extern const uint8_t color_brightness_pct[COLOR_BRIGHTNESS_LEVELS];
+
+// =====================================================
+// Precomputed color table
+// =====================================================
+// Every (scheme, second, brightness) combination resolved once at boot:
+// the radio tick and the display read one entry instead of a switch plus
+// three divisions. Seconds at or above COLOR_LUT_SECONDS all share the last
+// row, so the table stays a few hundred bytes
+#define COLOR_LUT_SECONDS (URGENT_COUNTDOWN_THRESHOLD_SEC + 1)
+
+typedef struct {
+  color_t rgb;        // brightness-scaled, as carried in the radio frame
+  uint16_t rgb565_be; // same color as ST7735 RGB565, already byte-swapped
+} color_lut_entry_t;
+
+extern color_lut_entry_t color_lut[COLOR_SCHEME_COUNT][COLOR_LUT_SECONDS]
+                                  [COLOR_BRIGHTNESS_LEVELS];
+
+// Fill color_lut; call once before the first color_lookup()
+void colors_init(void);
+
+// seconds == 0xFF (expired) is treated like zero. An unknown scheme reads
+// as COLOR_SCHEME_CUSTOM (as get_sport_color() does) and an out-of-range
+// brightness as the dimmest level, never past the table
+static inline const color_lut_entry_t *
+color_lookup(color_scheme_t scheme, uint8_t seconds, uint8_t brightness_idx) {
+  uint8_t row = (seconds == 0xFF) ? 0
+                : (seconds < COLOR_LUT_SECONDS) ? seconds
+                                                : COLOR_LUT_SECONDS - 1;
+  if ((unsigned)scheme >= COLOR_SCHEME_COUNT)
+    scheme = COLOR_SCHEME_CUSTOM;
+  if (brightness_idx >= COLOR_BRIGHTNESS_LEVELS)
+    brightness_idx = COLOR_BRIGHTNESS_LEVELS - 1;
+  return &color_lut[scheme][row][brightness_idx];
+}
+
 // Function to get color based on sport and time value
 color_t get_sport_color(color_scheme_t scheme, uint8_t seconds);
 
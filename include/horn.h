@@ -0,0 +1,55 @@
+#pragma once
+
+#include "driver/gpio.h"
+#include "esp_timer.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Local horn / active buzzer (driven high through a transistor or relay).
+// Each crossing is a one-shot esp_timer armed for the exact instant the
+// clock gets there, so the blast does not wait for the control loop
+#define HORN_ZERO_MS 1000     // clock expired
+#define HORN_WARN_MS 200      // warn_at_10 sports: crossing 10 s
+#define HORN_WARN_AT_MS 10000 // warning crossing
+
+typedef enum {
+  HORN_EVENT_NONE = 0,
+  HORN_EVENT_WARN,
+  HORN_EVENT_ZERO
+} HornEvent;
+
+// Last blast: the crossing instant vs when the pin actually went high
+// (esp_timer time, the same clock TimerManager runs on)
+typedef struct {
+  HornEvent event;
+  int64_t target_us;
+  int64_t fired_us;
+} HornReport;
+
+typedef struct {
+  gpio_num_t pin; // GPIO_NUM_NC = silent (timing is still scheduled/logged)
+  esp_timer_handle_t event_timer; // next crossing
+  esp_timer_handle_t off_timer;   // ends the current blast
+
+  // Armed crossings; 0 = none
+  int64_t warn_at_us;
+  int64_t zero_at_us;
+
+  HornReport report;
+  bool report_pending;
+  int64_t max_late_us; // worst lateness since boot
+
+  bool initialized;
+} Horn;
+
+bool horn_init(Horn *horn, gpio_num_t pin);
+
+// Re-arm from the clock state after any start/stop/adjust/reset:
+// stopped (paused) cancels what is pending, running arms the crossings at
+// sample_us + remaining_us. A blast already sounding is left to finish
+void horn_schedule(Horn *horn, bool running, int64_t remaining_us,
+                   int64_t sample_us, bool warn_at_10);
+
+// Logs the accuracy of the last blast once (control-loop context: never
+// from the esp_timer task, where it would delay the radio deadlines)
+void horn_log_report(Horn *horn);
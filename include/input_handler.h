@@ -8,6 +8,11 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+// Poll cadence while an input is mid-gesture (debounce window open, control
+// button held, double-tap window, rotary backlog). Settled inputs are not
+// polled at all: a GPIO edge wakes the control loop (MAIN_EVT_INPUT)
+#define INPUT_ACTIVE_POLL_MS 10
+
 typedef enum {
   INPUT_ACTION_NONE = 0,
 
@@ -71,3 +76,7 @@ void input_handler_init(InputHandler *h, gpio_num_t control_pin,
 
 InputAction input_handler_update(InputHandler *h, SportManager *sport_mgr,
                                  TimerManager *timer_mgr);
+
+// True when nothing is pending that only a later poll (not an edge) can
+// complete; otherwise poll again within INPUT_ACTIVE_POLL_MS
+bool input_handler_is_settled(const InputHandler *h);
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Control-loop wake-ups. The loop blocks on its task notification until a
+// source posts a bit or its next deadline (one-shot esp_timer) expires, so
+// it runs exactly when something can have changed instead of every 50 ms
+#define MAIN_EVT_INPUT (1u << 0)    // button / rotary GPIO edge
+#define MAIN_EVT_WATCH (1u << 1)    // ESP-NOW watch command queued
+#define MAIN_EVT_LINK (1u << 2)     // radio link_good flipped
+#define MAIN_EVT_DEADLINE (1u << 3) // main_events_wait() deadline reached
+
+// Longest sleep without any event: a missed edge (or a bug in a deadline)
+// costs at most this much latency, never a hang
+#define MAIN_EVENTS_MAX_SLEEP_MS 1000
+
+// Wake-up counters since the last main_events_take_stats()
+typedef struct {
+  uint32_t wakes;
+  uint32_t input;
+  uint32_t watch;
+  uint32_t link;
+  uint32_t deadline;
+  uint32_t timeout; // MAIN_EVENTS_MAX_SLEEP_MS fallback
+} MainEventStats;
+
+// Call from the control-loop task before any source can post
+bool main_events_init(void);
+
+// Safe before main_events_init() (dropped) and from any task
+void main_events_post(uint32_t bits);
+// GPIO ISRs (IRAM)
+void main_events_post_from_isr(uint32_t bits);
+
+// Block until an event or until delay_us has passed (< 0 = no deadline,
+// 0 = don't block). Returns the MAIN_EVT_* bits that ended the wait
+uint32_t main_events_wait(int64_t delay_us);
+
+void main_events_take_stats(MainEventStats *out);
@@ -4,31 +4,111 @@
 #include "../../radio-common/include/radio_config.h"
 #include "driver/gpio.h"
 #include "driver/spi_master.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "radio_tx_cadence.h"
 #include <stdbool.h>
 #include <stdint.h>
 
 // Radio timing constants
+// Safety bound per copy: a broadcast copy completes in well under 1 ms, so
+// hitting this means a wedged chip (or an unwired IRQ line)
 #define RADIO_TRANSMIT_TIMEOUT_MS 30
-// Copies of the same frame sent back-to-back per tick: WiFi interference is
-// bursty, so closely spaced duplicates give one copy a good chance of landing
-// in a clean gap. Receivers are stateless and treat duplicates as no-ops.
-#define RADIO_TX_BURST_COUNT 3
+// Status poll interval when no IRQ pin is wired
+#define RADIO_TX_POLL_INTERVAL_US 50
+// Copies per tick: RADIO_TX_BURST_COUNT/RADIO_TX_BURST_MAX (radio_tx_cadence.h)
+// TX FIFO depth: up to this many copies are preloaded at once, longer bursts
+// top the FIFO up as copies go out
+#define RADIO_TX_FIFO_DEPTH 3
+// Silence between copies. 0 = preload all copies into the TX FIFO and air
+// them back to back; >0 = one copy at a time, spaced this far apart so the
+// burst straddles a WiFi burst (radio_set_burst_gap_us() at runtime)
+#define RADIO_TX_BURST_GAP_US 0
+// Power-down -> standby crystal start-up before the first CE pulse
+#define RADIO_PWR_UP_SETTLE_US 2000
+// How often the register shadow is checked against the chip (brown-out)
+#define RADIO_SHADOW_VERIFY_INTERVAL_MS 1000
+// Shadowed registers: CONFIG (0x00) .. RF_SETUP (0x06)
+#define RADIO_SHADOW_REGS 0x07
+// RF_CH, rewritten by radio-common on every retune and survey
+#define RADIO_SHADOW_REG_RF_CH 0x05
 #define RADIO_LINK_SUCCESS_WINDOW_MS 5000
 #define RADIO_LINK_FAILURE_WINDOW_MS 2000
 #define RADIO_LINK_LOG_INTERVAL_MS 10000
 #define RADIO_LINK_SUCCESS_RATE_THRESHOLD 0.5f
 #define RADIO_LINK_QUALITY_THRESHOLD 0.7f
+// Link statistics cover the ticks of the last RADIO_STATS_WINDOW_MS, held in
+// a ring sized for 10 Hz (tenths mode) over that span. One entry per tick:
+// only time frames are recorded, not the extended frames that follow them
+#define RADIO_STATS_WINDOW_MS 5000
+#define RADIO_STATS_RING_LEN 64
+// Weight of the newest tick in the smoothed success rate
+#define RADIO_STATS_EWMA_ALPHA 0.125f
+
+// Burst accounting since the last radio_reset_tx_stats(); what
+// RADIO_TX_BURST_COUNT and the gap are tuned from. Airtime is CE-high (or the
+// previous copy's completion, in FIFO mode) to TX_DS seen by the task; gap is
+// the measured silence between copies (spread mode only)
+typedef struct {
+  uint32_t bursts;
+  uint32_t copies_aired;
+  uint32_t copies_lost;
+  uint32_t airtime_us_sum;
+  uint32_t airtime_us_max;
+  uint32_t airtime_samples;
+  uint32_t gap_us_sum;
+  uint32_t gap_us_max;
+  uint32_t gap_samples;
+} RadioTxStats;
+
+// One radio_send_time() call: did any copy air, and how long the burst took
+typedef struct {
+  uint32_t time_ms;
+  uint32_t latency_us;
+  bool ok;
+} RadioTickSample;
+
+// Link quality over the sliding window (radio_get_stats())
+typedef struct {
+  uint16_t window_ticks;   // ticks inside RADIO_STATS_WINDOW_MS
+  uint16_t window_ok;      // ticks with at least one copy aired
+  float success_rate;      // window_ok / window_ticks (0 when empty)
+  float success_ewma;      // per-tick smoothed success, alpha 1/8
+  uint32_t latency_p50_us; // burst completion time, successful ticks only
+  uint32_t latency_p99_us;
+  uint32_t total_ok;       // lifetime counters, for the log only
+  uint32_t total_failed;
+} RadioLinkStats;
 
 // Radio communication structure - extends RadioCommon with controller-specific
 // fields
 typedef struct {
   RadioCommon base; // radio-common base structure
 
+  // nRF24 IRQ line (active low on TX_DS/MAX_RT). GPIO_NUM_NC = poll STATUS
+  gpio_num_t irq_pin;
+  volatile TaskHandle_t tx_waiter; // task blocked on the current copy
+
+  // Write-through register shadow; bit n of shadow_valid = shadow[n] known
+  uint8_t shadow[RADIO_SHADOW_REGS];
+  uint32_t shadow_valid;
+  uint32_t shadow_verified_ms;
+  // Chip left power-down since the last full invalidate. Survives a retune or
+  // a survey's PRIM_RX flip, which never clear PWR_UP
+  bool powered;
+  bool tx_fifo_dirty; // a burst timed out and may have left copies queued
+
   // Link status tracking
   uint32_t last_success_time;
   uint32_t last_failure_time;
-  uint16_t success_count;
-  uint16_t failure_count;
+  uint32_t success_count; // lifetime
+  uint32_t failure_count;
+
+  // Per-tick outcomes, newest at ring_head - 1
+  RadioTickSample ring[RADIO_STATS_RING_LEN];
+  uint8_t ring_head;
+  uint8_t ring_count;
+  float success_ewma;
 
   // ACK payload tracking
   bool ack_received;    // true if last TX got an ACK payload
@@ -39,17 +119,56 @@ typedef struct {
   // Runtime state (moved from static variables)
   bool led_state;
   uint32_t last_log_time;
+  uint32_t last_burst_us; // wall time of the last radio_send_time() burst
+  uint32_t tx_gap_us;     // 0 = FIFO burst, see RADIO_TX_BURST_GAP_US
+  uint8_t tx_copies;      // copies per burst, see RADIO_TX_BURST_COUNT
+  RadioTxStats tx_stats;
 } RadioComm;
 
 // Function declarations
-bool radio_begin(RadioComm *radio, gpio_num_t ce, gpio_num_t csn);
+// irq: GPIO wired to the nRF24 IRQ pin, or GPIO_NUM_NC to poll STATUS
+bool radio_begin(RadioComm *radio, gpio_num_t ce, gpio_num_t csn,
+                 gpio_num_t irq);
 
 // Send main payload: seconds + RGB + sequence
 bool radio_send_time(RadioComm *radio, uint16_t seconds, uint8_t r, uint8_t g,
                      uint8_t b, uint8_t sequence);
 
+// Channel-switch announcement (radio_frame.h): "moving to target_channel
+// after switch_sequence". Same burst as a time frame; like the clock and
+// timer frames it stays out of the per-tick link stats
+bool radio_send_switch(RadioComm *radio, uint8_t target_channel,
+                       uint8_t switch_sequence, uint8_t sequence);
+
+// Clock frame for free-running displays (radio_frame.h): remaining ms,
+// RADIO_FRAME_CLOCK_* flags and the discontinuity epoch
+bool radio_send_clock(RadioComm *radio, uint32_t remaining_ms,
+                      uint8_t clock_flags, uint8_t epoch, uint8_t sequence);
+
+// Timer frame for a court timer on stream channel 1-3 (radio_frame.h)
+bool radio_send_timer(RadioComm *radio, uint8_t timer_channel,
+                      uint32_t remaining_ms, uint8_t clock_flags,
+                      uint8_t epoch, uint8_t sequence);
+
 bool radio_is_transmit_complete(RadioComm *radio);
 
+// Put the chip in TX standby. Free when the shadow already says so; after
+// re-configuring the chip call radio_shadow_invalidate() first
+void radio_enter_tx(RadioComm *radio);
+void radio_shadow_invalidate(RadioComm *radio);
+
+// Retune and return to TX (radio_common_set_channel + shadow upkeep). Only
+// CONFIG and RF_CH are re-learned, so a retune after a survey costs the
+// CONFIG write but not the power-up settle
+void radio_set_channel(RadioComm *radio, uint8_t channel);
+
+// Switch burst mode at runtime: 0 = FIFO burst, >0 = copies spaced gap_us
+void radio_set_burst_gap_us(RadioComm *radio, uint32_t gap_us);
+// Copies per radio_send_time() burst, clamped to 1..RADIO_TX_BURST_MAX
+void radio_set_burst_copies(RadioComm *radio, uint8_t copies);
+void radio_get_tx_stats(const RadioComm *radio, RadioTxStats *out);
+void radio_reset_tx_stats(RadioComm *radio);
+
 // Re-configure a wedged radio (e.g. after brown-out) and restore TX mode.
 // Never restarts the MCU - the controller's running timer must survive
 bool radio_recover(RadioComm *radio);
@@ -57,6 +176,10 @@ void radio_flush_tx(RadioComm *radio);
 void radio_dump_registers(RadioComm *radio);
 void radio_update_link_status(RadioComm *radio);
 
+// Windowed link statistics. Reads the tick ring: call from the task that owns
+// the radio (or with the radio locked)
+void radio_get_stats(const RadioComm *radio, RadioLinkStats *out);
+
 // Helper: check if last TX got a matching ACK sequence
 static inline bool radio_last_ack_ok(const RadioComm *radio,
                                      uint8_t sent_sequence) {
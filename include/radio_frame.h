@@ -0,0 +1,180 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// 6-byte frame encoding shared with the receivers. Pure C (no ESP-IDF), so
+// the receiver firmware can take it as-is
+//
+// Time frame (legacy):
+//   [0..1] time value, big-endian ([0] is only ever 0x00/0x01/0x80/0x81)
+//   [2..4] RGB   [5] sequence
+// Channel-switch announcement:
+//   [0] RADIO_FRAME_MARKER_SWITCH   [1] target channel
+//   [2] switch sequence N: the last frame aired on the old channel
+//   [3] check byte (see radio_frame_switch_check)   [4] 0   [5] sequence
+// Clock frame (free-running displays):
+//   [0] RADIO_FRAME_MARKER_CLOCK
+//   [1] bits 7-6 version, bit 5 running, bit 4 warn-at-10, bit 3 null
+//       signal, bits 2-0 epoch
+//   [2..4] remaining milliseconds, big-endian   [5] sequence
+// Timer frame (court timers on stream channels 1-3, e.g. the game clock):
+//   [0] RADIO_FRAME_MARKER_TIMER
+//   [1] bits 7-6 stream channel, bit 5 running, bit 4 mm:ss format, bit 3
+//       null signal, bits 2-0 epoch
+//   [2..4] remaining milliseconds, big-endian   [5] sequence
+// The play clock is stream channel 0: its clock frame is unchanged
+// An announcement, clock or timer frame carries the sequence of the time
+// frame it follows. Receivers already in the field know none of the markers
+// and don't drop repeated sequences: they decode every frame as a time and
+// would show garbage. Announcements, clock and timer frames are therefore
+// only aired when the controller's policy opts in
+// (RadioTxPolicy.extended_frames), once every display on the link decodes
+// them. Colors still come from the time frames
+#define RADIO_FRAME_SIZE 6
+#define RADIO_FRAME_MARKER_SWITCH 0x7F
+#define RADIO_FRAME_MARKER_CLOCK 0x7E
+#define RADIO_FRAME_MARKER_TIMER 0x7D
+
+#define RADIO_FRAME_CLOCK_VERSION 1
+#define RADIO_FRAME_CLOCK_RUNNING 0x20
+#define RADIO_FRAME_CLOCK_WARN10 0x10
+#define RADIO_FRAME_CLOCK_NULL 0x08
+#define RADIO_FRAME_CLOCK_EPOCH_MASK 0x07
+#define RADIO_FRAME_CLOCK_MAX_MS 0xFFFFFF
+#define RADIO_FRAME_CLOCK_MMSS 0x10 // timer frames: the WARN10 bit
+#define RADIO_FRAME_TIMER_CHANNELS 4 // stream channels, 0 = play clock
+
+// Controller: announcement ticks before a hop (at the active keep-alive,
+// 4 x 250 ms = 1 s of warning)
+#define RADIO_SWITCH_ANNOUNCE_TICKS 4
+
+// Receiver: hop anyway this long after the first announcement heard, in case
+// every frame up to N is lost (announce window plus one keep-alive of slack)
+#define RADIO_SWITCH_HOP_TIMEOUT_MS 1500
+
+typedef enum {
+  RADIO_FRAME_INVALID = 0,
+  RADIO_FRAME_TIME,
+  RADIO_FRAME_SWITCH,
+  RADIO_FRAME_CLOCK,
+} radio_frame_type_t;
+
+typedef struct {
+  radio_frame_type_t type;
+  uint8_t sequence;
+  // RADIO_FRAME_TIME
+  uint16_t time_value;
+  uint8_t r, g, b;
+  // RADIO_FRAME_SWITCH
+  uint8_t target_channel;
+  uint8_t switch_sequence;
+  // RADIO_FRAME_CLOCK
+  uint32_t remaining_ms;
+  uint8_t clock_flags; // RADIO_FRAME_CLOCK_RUNNING | _WARN10 | _NULL
+  uint8_t epoch;       // bumped on start/stop/reset/adjust, wraps at 8
+  uint8_t timer_channel; // 0 = play clock (clock frame), 1-3 timer frames
+} RadioFrame;
+
+void radio_frame_encode_time(uint8_t *out, uint16_t time_value, uint8_t r,
+                             uint8_t g, uint8_t b, uint8_t sequence);
+void radio_frame_encode_switch(uint8_t *out, uint8_t target_channel,
+                               uint8_t switch_sequence, uint8_t sequence);
+void radio_frame_encode_clock(uint8_t *out, uint32_t remaining_ms,
+                              uint8_t clock_flags, uint8_t epoch,
+                              uint8_t sequence);
+// timer_channel 0 encodes the play clock's clock frame; 1-3 a timer frame
+// (RADIO_FRAME_CLOCK_MMSS in place of _WARN10)
+void radio_frame_encode_timer(uint8_t *out, uint8_t timer_channel,
+                              uint32_t remaining_ms, uint8_t clock_flags,
+                              uint8_t epoch, uint8_t sequence);
+// Unknown clock-frame versions decode as RADIO_FRAME_INVALID
+radio_frame_type_t radio_frame_decode(const uint8_t *in, RadioFrame *out);
+
+// -----------------------------------------------------------------------------
+// Reference receiver: channel following. Feed every decoded frame; when it
+// returns true the receiver retunes to rx->channel immediately instead of
+// scanning RADIO_CHANNEL_CANDIDATES. Call radio_frame_rx_poll() while
+// idle so a lost tail of the announcement still hops on timeout
+// -----------------------------------------------------------------------------
+typedef struct {
+  uint8_t channel;
+  bool switch_pending;
+  uint8_t target_channel;
+  uint8_t switch_sequence;
+  uint32_t pending_since_ms;
+} RadioFrameRx;
+
+void radio_frame_rx_init(RadioFrameRx *rx, uint8_t channel);
+bool radio_frame_rx_feed(RadioFrameRx *rx, const RadioFrame *frame,
+                         uint32_t now_ms);
+bool radio_frame_rx_poll(RadioFrameRx *rx, uint32_t now_ms);
+
+// -----------------------------------------------------------------------------
+// Reference receiver: free-running display. Counts down locally from the
+// last clock frame and only corrects from each new one, so a lost frame no
+// longer freezes a digit. Within one epoch a correction upwards smaller
+// than RADIO_CLOCK_RX_NO_BOUNCE_MS is ignored (no visible digit bounce);
+// a new epoch is a real jump (reset, adjust, start/stop) and always taken.
+// Each display follows one stream channel (0 = play clock) and ignores the
+// clock/timer frames of the others
+// -----------------------------------------------------------------------------
+#define RADIO_CLOCK_RX_NO_BOUNCE_MS 100
+
+typedef struct {
+  bool valid;
+  bool running;
+  bool null_signal;
+  bool mmss; // timer frames: show mm:ss above a minute
+  uint8_t timer_channel;
+  uint8_t epoch;
+  uint32_t remaining_ms; // at rx_ms
+  uint32_t rx_ms;
+} RadioClockRx;
+
+void radio_clock_rx_init(RadioClockRx *rx, uint8_t timer_channel);
+void radio_clock_rx_feed(RadioClockRx *rx, const RadioFrame *frame,
+                         uint32_t now_ms);
+uint32_t radio_clock_rx_remaining_ms(const RadioClockRx *rx, uint32_t now_ms);
+
+// Value the displays show for a remaining time: whole seconds (ceiling),
+// tenths inside the final 5 s, in ms so two displays can be compared
+uint32_t radio_frame_display_ms(uint32_t remaining_ms);
+
+// -----------------------------------------------------------------------------
+// Loss benchmark: a scripted game clock (24 s, stop at 14.2 s for 2 s,
+// restart, run out) aired at the controller's cadence with a deterministic
+// loss_pct of ticks dropped. Three displays: a legacy one on the default
+// stream (time frames only), the same legacy display with extended frames
+// on (it reads the clock frame's bytes as a time, as deployed receivers
+// do), and a free-running one on the extended stream. Errors compare the
+// displayed value with the controller's own, in 10 ms steps
+// -----------------------------------------------------------------------------
+typedef struct {
+  uint8_t loss_pct;
+  uint32_t ticks;
+  uint32_t ticks_lost;
+  uint32_t sim_ms;
+  uint32_t legacy_wrong_ms; // time showing a different value
+  uint32_t legacy_max_err_ms;
+  uint64_t legacy_err_sum_ms; // sum of |error| over the 10 ms steps
+  uint32_t mixed_wrong_ms;    // legacy display, extended frames on
+  uint32_t mixed_max_err_ms;
+  uint64_t mixed_err_sum_ms;
+  uint32_t clock_wrong_ms;
+  uint32_t clock_max_err_ms;
+  uint64_t clock_err_sum_ms;
+} RadioFrameLossResult;
+
+// The TX cadence replayed: the caller passes the controller's own
+// (RadioTxPolicy keep-alives, RADIO_TX_EPOCH_FAST_MS) so the benchmark
+// tracks what is actually aired
+typedef struct {
+  uint32_t active_keepalive_ms; // running, or just after start/stop
+  uint32_t idle_keepalive_ms;   // paused or at zero
+  uint32_t epoch_fast_ms;       // active keep-alive after start/stop
+} RadioFrameLossCadence;
+
+void radio_frame_loss_benchmark(const RadioFrameLossCadence *cadence,
+                                uint8_t loss_pct, uint32_t seed,
+                                RadioFrameLossResult *out);
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "colors.h"
+#include "timer_manager.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// When the radio TX task airs a tick and how many copies it carries: value
+// changes at once, an unchanged value at the policy's keep-alive, extra
+// copies in the final seconds. Pure C (no ESP-IDF, no clock of its own):
+// driven by the TX task at each wake-up, and replayable on a host against
+// the receiver staleness bound
+
+// Copies of the same frame sent back-to-back per tick: WiFi interference is
+// bursty, so closely spaced duplicates give one copy a good chance of landing
+// in a clean gap. Receivers are stateless and treat duplicates as no-ops.
+#define RADIO_TX_BURST_COUNT 3
+// Upper bound for radio_set_burst_copies() (the final-seconds boost)
+#define RADIO_TX_BURST_MAX 6
+_Static_assert(RADIO_TX_BURST_COUNT <= RADIO_TX_BURST_MAX,
+               "default burst exceeds RADIO_TX_BURST_MAX");
+
+// Broadcast policy defaults. Value changes always go out at once; these
+// only set how often an unchanged value is re-aired and how many copies a
+// burst carries
+#define RADIO_TX_ACTIVE_KEEPALIVE_MS 250 // counting down
+#define RADIO_TX_IDLE_KEEPALIVE_MS 1000  // paused, at zero, or null signal
+#define RADIO_TX_FINAL_WINDOW_MS 3000    // last seconds get the boost
+#define RADIO_TX_FINAL_COPIES 5
+
+// Clock frames (radio_frame.h) follow each time frame when the policy opts
+// in to extended frames (off by default: deployed receivers would show them
+// as garbage times). A start/stop/null change, or a jump against the
+// extrapolated clock bigger than EPOCH_JUMP_US (reset, officials' adjust),
+// starts a new epoch: aired at once, then at the active keep-alive for
+// EPOCH_FAST_MS so free-running displays stop/start with the controller
+// even when paused
+#define RADIO_TX_EPOCH_JUMP_US 50000
+#define RADIO_TX_EPOCH_FAST_MS 1000
+// Extended frames go out once per tick: a free-running display rides out a
+// lost one, and the epoch fast keep-alive re-airs the tick anyway
+#define RADIO_TX_EXTENDED_COPIES 1
+
+// Receiver model: a display that hears nothing for this long is considered
+// stale (the bound the policy is checked against, at build time for the
+// defaults and at radio_tx_start() for a custom policy)
+#define RADIO_RX_STALE_BOUND_MS 1500
+
+_Static_assert(RADIO_TX_ACTIVE_KEEPALIVE_MS <= RADIO_RX_STALE_BOUND_MS &&
+                   RADIO_TX_IDLE_KEEPALIVE_MS <= RADIO_RX_STALE_BOUND_MS,
+               "keep-alive slower than the receiver staleness bound");
+_Static_assert(RADIO_TX_FINAL_COPIES <= RADIO_TX_BURST_MAX,
+               "final-seconds burst exceeds RADIO_TX_BURST_MAX");
+_Static_assert(RADIO_TX_EXTENDED_COPIES >= 1 &&
+                   RADIO_TX_EXTENDED_COPIES <= RADIO_TX_BURST_MAX,
+               "extended-frame burst outside 1..RADIO_TX_BURST_MAX");
+
+// Below this the clock is shown and carried in deciseconds
+#define RADIO_TX_TENTHS_WINDOW_MS TIMER_TENTHS_WINDOW_MS
+
+typedef struct {
+  uint32_t active_keepalive_ms;
+  uint32_t idle_keepalive_ms;
+  uint32_t final_window_ms;
+  uint8_t copies;          // burst copies normally
+  uint8_t final_copies;    // burst copies while running inside final_window_ms
+  bool auto_migrate;       // move off a degraded channel on our own
+  bool extended_frames;    // air clock/timer frames (displays decode them)
+  uint8_t extended_copies; // burst copies of each extended frame
+} RadioTxPolicy;
+
+#define RADIO_TX_POLICY_DEFAULT                                              \
+  ((RadioTxPolicy){.active_keepalive_ms = RADIO_TX_ACTIVE_KEEPALIVE_MS,      \
+                   .idle_keepalive_ms = RADIO_TX_IDLE_KEEPALIVE_MS,          \
+                   .final_window_ms = RADIO_TX_FINAL_WINDOW_MS,              \
+                   .copies = RADIO_TX_BURST_COUNT,                           \
+                   .final_copies = RADIO_TX_FINAL_COPIES,                    \
+                   .auto_migrate = true,                                     \
+                   .extended_frames = false,                                 \
+                   .extended_copies = RADIO_TX_EXTENDED_COPIES})
+
+// Keep-alives within the staleness bound, copy counts within the burst
+// limits
+bool radio_tx_policy_valid(const RadioTxPolicy *p);
+
+// One wake-up of the TX task: the play clock as it stands at now_us
+typedef struct {
+  int64_t now_us;
+  uint32_t rem_us;
+  bool running;
+  bool send_null; // carry TIMER_NULL_SIGNAL so displays clear
+  bool warn_at_10;
+  color_t color;
+  bool new_epoch; // a clock or court timer epoch starts at this wake-up
+  bool switching; // channel-switch announcement ticks still to air
+} RadioTxTick;
+
+typedef struct {
+  bool air;             // a tick goes out now
+  uint16_t value;       // time frame value
+  uint8_t copies;       // burst copies of the time frame
+  int64_t keepalive_us; // re-air an unchanged value this long after a tick
+} RadioTxPlan;
+
+// What was last aired. last_value RADIO_TX_VALUE_NONE airs at the next
+// wake-up whatever it carries
+#define RADIO_TX_VALUE_NONE 0xFFFF
+
+typedef struct {
+  int64_t last_tx_us;
+  uint16_t last_value;
+  color_t last_color;
+  int64_t epoch_at_us; // last epoch start (extended frames' fast keep-alive)
+} RadioTxCadence;
+
+void radio_tx_cadence_init(RadioTxCadence *c);
+
+// Decide this wake-up's tick (records the epoch start, if any)
+void radio_tx_cadence_plan(RadioTxCadence *c, const RadioTxPolicy *p,
+                           const RadioTxTick *t, RadioTxPlan *plan);
+
+// The planned tick went out (or was attempted: a failed burst is not
+// retried before its keep-alive)
+void radio_tx_cadence_sent(RadioTxCadence *c, const RadioTxTick *t,
+                           const RadioTxPlan *plan);
+
+// Next wake-up: the keep-alive after the last tick, or the moment the
+// carried value changes if that comes first
+int64_t radio_tx_cadence_deadline(const RadioTxCadence *c,
+                                  const RadioTxTick *t,
+                                  const RadioTxPlan *plan);
+
+// Air at the next wake-up (first frame, switch announced, channel hopped)
+void radio_tx_cadence_force(RadioTxCadence *c);
+
+// The value is carried in deciseconds (4.9s gets the <5s color, too)
+bool radio_tx_cadence_tenths(uint32_t rem_ms);
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "channel_migrator.h"
+#include "colors.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "radio_comm.h"
+#include "radio_frame.h"
+#include "radio_tx_cadence.h"
+#include "timer_manager.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Radio TX task: frames go out at the exact moment the carried value
+// changes (each second, each decisecond in the final 5s) from an esp_timer
+// deadline, independent of the control loop's wake-ups and UI work. What
+// goes out when is decided by radio_tx_cadence.h
+#define RADIO_TX_TASK_STACK 4096
+#define RADIO_TX_TASK_PRIORITY 10 // above the render task (4) on its core
+#define RADIO_TX_TASK_CORE 1
+
+// Background channel sampling: after each aired burst, one candidate gets a
+// few RPD samples in the idle gap (~1 ms each), round-robin, so the channel
+// menu always has live scores without a blocking survey. Skipped when the
+// next deadline is closer than the guard
+#define RADIO_BG_SURVEY_SAMPLES 4
+#define RADIO_BG_SURVEY_GUARD_US 15000
+#define RADIO_BG_SURVEY_EWMA_SHIFT 3 // alpha = 1/8, ~10 s at 4 Hz / 6 ch
+
+// Automatic migration (channel_migrator.h) is evaluated this often, from
+// the background occupancy and the windowed TX success
+#define RADIO_MIGRATE_EVAL_MS 1000
+
+// Re-configure the radio after this many consecutive TX failures (~5s at
+// the active keep-alive)
+#define RADIO_CONSEC_FAIL_LIMIT 20
+
+// Court timers (TimerManager ids other than TIMER_PLAY, e.g. the game
+// clock) ride along with clock frames, so also only with extended frames:
+// each tick that airs the play clock also airs one timer frame per running
+// court timer on its stream channel (a stopped one at the idle keep-alive,
+// or every tick for EPOCH_FAST_MS after its epoch changed). The displays
+// free-run between frames, so no per-timer deadlines are needed
+#define RADIO_TX_COURT_TIMERS (TIMER_MAX_TIMERS - 1)
+
+typedef struct {
+  int64_t remaining_us; // exact at the snapshot's taken_us
+  bool running;
+  bool mmss;
+  uint8_t channel; // stream channel 1-3
+} RadioTimerSnapshot;
+
+// Clock state as published by the control loop. remaining_us was exact at
+// taken_us (TimerManager's esp_timer sample); while running the task
+// extrapolates from there
+typedef struct {
+  uint32_t remaining_us;
+  int64_t taken_us;
+  bool running;
+  bool send_null; // 3s after zero: carry TIMER_NULL_SIGNAL so displays clear
+  bool warn_at_10;
+  color_scheme_t color_scheme;
+  uint8_t brightness_idx;
+  uint8_t court_count;
+  RadioTimerSnapshot court[RADIO_TX_COURT_TIMERS];
+} RadioClockSnapshot;
+
+// What a receiver that hears every aired frame would have seen since the
+// last periodic log: longest silence, and how often it exceeded the bound.
+// The follower is the reference receiver (radio_frame.h) fed the decoded
+// frames, to check that announced switches re-acquire in one tick
+typedef struct {
+  int64_t last_frame_us;
+  uint32_t max_silence_us;
+  uint32_t stale_events;
+  RadioFrameRx follower;
+  int64_t follower_hop_us; // 0 = no switch in progress
+} RadioRxModel;
+
+// Per-candidate occupancy (index = position in RADIO_CHANNEL_CANDIDATES).
+// score_q8 is a decayed busy count in RADIO_SURVEY_SAMPLES units x256 (same
+// scale as a blocking survey); the totals are the long-term noise profile
+typedef struct {
+  uint32_t score_q8[RADIO_CHANNEL_CANDIDATE_COUNT];
+  uint32_t busy_total[RADIO_CHANNEL_CANDIDATE_COUNT];
+  uint32_t samples_total[RADIO_CHANNEL_CANDIDATE_COUNT];
+  uint8_t next; // round-robin cursor
+} RadioChannelProfile;
+
+// Deadline lateness (wake-up to burst start) since the last periodic log
+typedef struct {
+  uint32_t samples;
+  uint32_t sum_us;
+  uint32_t max_us;
+} RadioTxJitter;
+
+typedef struct {
+  RadioComm *radio;
+  RadioTxPolicy policy;
+  TaskHandle_t task;
+  esp_timer_handle_t timer;
+  SemaphoreHandle_t wake; // given by the deadline timer and by publishers
+  SemaphoreHandle_t lock; // radio SPI ownership (task vs. radio_tx_lock())
+
+  // Seqlock-protected snapshot: odd seq = write in progress
+  volatile uint32_t seq;
+  RadioClockSnapshot snap;
+
+  // Pending channel-switch request: 0 = none, else 0x100 | channel
+  volatile uint16_t switch_request;
+
+  // Task-private
+  int64_t next_deadline_us; // 0 = none armed
+  RadioTxCadence cadence;
+  uint8_t sequence;
+  uint16_t consecutive_failures;
+  uint8_t epoch;
+  RadioClockSnapshot prev_snap; // last wake-up, for epoch detection
+  uint32_t prev_rem_us;
+  int64_t prev_now_us; // 0 = no previous wake-up
+  uint8_t court_epoch[RADIO_TX_COURT_TIMERS];
+  int64_t court_epoch_at_us[RADIO_TX_COURT_TIMERS];
+  int64_t court_prev_rem_us[RADIO_TX_COURT_TIMERS];
+  int64_t court_last_tx_us[RADIO_TX_COURT_TIMERS]; // last timer frame aired
+  uint8_t switch_target;
+  uint8_t switch_sequence;   // last sequence aired on the old channel
+  uint8_t switch_ticks_left; // announcement ticks still to air; 0 = none
+  ChannelMigrator migrator;
+  uint32_t last_migrate_eval_ms;
+  RadioTxJitter jitter;
+  RadioRxModel rx_model;
+  RadioChannelProfile profile; // under lock
+  uint32_t frames_aired; // since the last periodic log
+  uint32_t last_log_ms;
+} RadioTx;
+
+// Create the task and its deadline timer; the radio must already be in TX
+// mode on its channel. From here on only the task touches the radio, except
+// between radio_tx_lock()/radio_tx_unlock(). policy NULL = defaults; a
+// policy that could leave receivers stale is rejected (defaults used)
+bool radio_tx_start(RadioTx *tx, RadioComm *radio,
+                    const RadioTxPolicy *policy);
+
+// Publish the current clock state (control loop, every iteration). Never
+// blocks; wakes the task so a start/stop/reset is aired immediately
+void radio_tx_publish(RadioTx *tx, const RadioClockSnapshot *snap);
+
+// Seed the profile with a blocking survey's scores (boot), so decay starts
+// from a full snapshot instead of zero
+void radio_tx_seed_channel_scores(RadioTx *tx, const uint16_t *scores);
+
+// Current decayed scores, RADIO_SURVEY_SAMPLES scale, one per candidate
+void radio_tx_get_channel_scores(RadioTx *tx, uint16_t *scores);
+
+// Move to another channel without dark displays: with extended frames on,
+// the task announces the switch for RADIO_SWITCH_ANNOUNCE_TICKS ticks (at
+// the active keep-alive, paused or not), then hops; otherwise it hops at
+// once and the receivers re-acquire by scanning. A later request replaces a
+// pending one. Also restarts the automatic migration rate limit
+void radio_tx_request_channel(RadioTx *tx, uint8_t channel);
+
+// Exclusive radio access for the control loop (diagnostics, register dumps)
+void radio_tx_lock(RadioTx *tx);
+void radio_tx_unlock(RadioTx *tx);
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "sport_selector.h"
+#include "timer_clock.h"
+#include "timer_manager.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Mirror of the game state in RTC_NOINIT memory, checksummed. It survives
+// panic, watchdog and brown-out resets (not power-on or esp_restart), so
+// boot can resume on a fast path: no sport menu, no channel survey, radio
+// before display, countdown advanced by the downtime. Only kept while the
+// clock screen shows, so resuming always lands there
+#define RESUME_STATE_MAGIC 0x52534D31 // "RSM1"
+#define RESUME_STATE_VERSION 1
+
+typedef struct {
+  sport_type_t sport;
+  uint8_t brightness_idx;
+  uint8_t channel;
+  TimerManager timer; // every timer, links and sample instant
+} ResumeState;
+
+// After every change (action, start/stop, channel move) on the clock
+// screen. Timer instants are stored against the RTC clock, which keeps
+// counting through a reset
+void resume_state_save(const TimerManager *timer_mgr, sport_type_t sport,
+                       uint8_t brightness_idx, uint8_t channel);
+
+// Boot: true + *out when the reset kept a valid snapshot. out->timer is
+// bound to clock and already advanced by the downtime (expiries during the
+// reset are stamped at their real instant). Anything else clears it
+bool resume_state_load(ResumeState *out, const TimerClock *clock);
+
+// Leaving the clock screen (menus): a reset then boots as usual
+void resume_state_clear(void);
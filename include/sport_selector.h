@@ -35,6 +35,9 @@ typedef struct {
     // Rules call for a buzzer when the count reaches 10 (football);
     // carried to receivers as RADIO_TIME_FLAG_WARN10
     bool warn_at_10;
+    // Game clock (mm:ss) run alongside the play clock on the same court;
+    // 0 = play clock only
+    uint16_t game_clock_seconds;
 } sport_config_t;
 
 sport_config_t get_sport_config(sport_type_t sport);
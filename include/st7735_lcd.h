@@ -42,6 +42,73 @@
 #define ST7735_COLMOD 0x3A
 #define ST7735_MADCTL 0x36
 
+// =====================================================
+// Transaction pipeline
+// =====================================================
+// Pre-allocated descriptors queued with spi_device_queue_trans(); the DC
+// line is driven from pre_cb, so commands and data queue back-to-back and
+// drawing returns while the DMA is still draining
+#define ST7735_TRANS_RING 8
+// Pixels per ping-pong line buffer (CPU fills one while DMA sends the other)
+#define ST7735_LINE_BUF_PX 2048
+
+// =====================================================
+// Shadow framebuffer (optional)
+// =====================================================
+// Dirty regions tracked between flushes; overlapping/near regions merge so a
+// flush streams a handful of windows instead of one per primitive
+#define ST7735_DIRTY_MAX 8
+// Extra pixels a merge may repaint before two regions stay separate (a window
+// set costs up to 5 transactions, so repainting a few clean pixels is cheaper)
+#define ST7735_DIRTY_MERGE_SLACK 512
+
+// Inclusive pixel bounds
+typedef struct {
+  int16_t x0;
+  int16_t y0;
+  int16_t x1;
+  int16_t y1;
+} St7735Region;
+
+// =====================================================
+// Glyph sprite cache
+// =====================================================
+// Clock glyphs pre-expanded at a given scale for one fg/bg pair, so drawing
+// a digit is a block copy (framebuffer) or one window + one DMA transfer
+#define ST7735_SPRITE_CHARS "0123456789."
+#define ST7735_SPRITE_COUNT (sizeof(ST7735_SPRITE_CHARS) - 1)
+#define ST7735_SPRITE_SLOTS 2
+
+typedef struct {
+  uint16_t *pixels; // ST7735_SPRITE_COUNT glyphs of (8*size)^2, panel order
+  uint16_t fg;
+  uint16_t bg;
+  uint8_t size;
+  bool valid;
+} St7735SpriteSet;
+
+// =====================================================
+// Batched primitives
+// =====================================================
+typedef struct {
+  int16_t x;
+  int16_t y;
+  int16_t w;
+  int16_t h;
+} St7735Rect;
+
+// =====================================================
+// SPI cost accounting
+// =====================================================
+// Running totals since the last st7735_stats_reset(); what a UI operation
+// costs on the wire, independent of timing
+typedef struct {
+  uint32_t commands;     // command bytes (DC low)
+  uint32_t data_bytes;   // parameter + pixel bytes (DC high)
+  uint32_t windows;      // CASET/RASET/RAMWR window sets
+  uint32_t transactions; // queued SPI transactions
+} St7735Stats;
+
 // =====================================================
 // Struct
 // =====================================================
@@ -55,6 +122,33 @@ typedef struct {
   uint16_t width;
   uint16_t height;
   bool initialized;
+
+  // Queued transaction ring: trans_head is the next slot to fill; results
+  // come back in queue order, so when the ring is full head is the oldest
+  spi_transaction_t trans[ST7735_TRANS_RING];
+  uint8_t trans_head;
+  uint8_t trans_in_flight;
+  uint8_t line_next; // ping-pong buffer to fill next
+
+  // Last CASET/RASET sent: a window sharing columns or rows with the
+  // previous one (text along a row, stacked boxes) skips that command
+  St7735Region win;
+  bool win_valid;
+
+  // Shadow framebuffer in panel byte order (NULL = primitives draw straight
+  // to the panel). Filled by primitives, pushed by st7735_flush()
+  uint16_t *fb;
+  St7735Region dirty[ST7735_DIRTY_MAX];
+  uint8_t dirty_count;
+
+  // Regions drawn while `urgent` is set; flushed first and never budgeted
+  St7735Region urgent_dirty[ST7735_DIRTY_MAX];
+  uint8_t urgent_count;
+  bool urgent;
+
+  St7735SpriteSet sprites[ST7735_SPRITE_SLOTS];
+
+  St7735Stats stats;
 } St7735Lcd;
 
 // =====================================================
@@ -63,6 +157,44 @@ typedef struct {
 bool st7735_begin(St7735Lcd *lcd, gpio_num_t cs, gpio_num_t dc, gpio_num_t rst,
                   gpio_num_t mosi, gpio_num_t sclk);
 
+// Switch to shadow-framebuffer mode: primitives only write RAM and
+// st7735_flush() streams the merged dirty regions. Returns false (and stays
+// in direct mode) if the 40 KB DMA-capable buffer can't be allocated
+bool st7735_framebuffer_enable(St7735Lcd *lcd);
+
+// Push all dirty regions to the panel; no-op in direct mode
+void st7735_flush(St7735Lcd *lcd);
+
+// Push all urgent regions, then normal regions up to max_bytes of pixel data
+// (a region is split on a row boundary). Returns the pixel bytes still dirty
+uint32_t st7735_flush_budget(St7735Lcd *lcd, uint32_t max_bytes);
+
+// Pixel bytes waiting for the next flush
+uint32_t st7735_pending_bytes(const St7735Lcd *lcd);
+
+// While set, primitives mark their area urgent: it jumps ahead of pending
+// bulk repaints at the next flush
+void st7735_set_urgent(St7735Lcd *lcd, bool urgent);
+
+// Collect finished transactions without blocking; true while any are still
+// in flight (a redraw is draining)
+bool st7735_busy(St7735Lcd *lcd);
+
+// Block until every queued transaction has gone out
+void st7735_wait_idle(St7735Lcd *lcd);
+
+// Pre-render ST7735_SPRITE_CHARS at this size/colour pair. A slot already
+// holding the size is re-rendered on a colour change; otherwise a free slot
+// is allocated. st7735_draw_char() uses matching sprites transparently
+bool st7735_sprite_cache_prepare(St7735Lcd *lcd, uint8_t size, uint16_t fg,
+                                 uint16_t bg);
+
+void st7735_stats_reset(St7735Lcd *lcd);
+
+// FNV-1a over the framebuffer (0 in direct mode): a compact fingerprint of
+// what a screen draws, comparable against known-good values across builds
+uint32_t st7735_framebuffer_checksum(const St7735Lcd *lcd);
+
 void st7735_clear(St7735Lcd *lcd, uint16_t color);
 void st7735_set_pixel(St7735Lcd *lcd, uint16_t x, uint16_t y, uint16_t color);
 void st7735_draw_rect(St7735Lcd *lcd, int x, int y, int w, int h,
@@ -71,6 +203,15 @@ void st7735_draw_rect(St7735Lcd *lcd, int x, int y, int w, int h,
 void st7735_draw_rect_outline(St7735Lcd *lcd, int x, int y, int w, int h,
                               uint16_t color);
 
+// Same-colour rectangles in one pass: the fill buffer is prepared once and
+// every window reuses it
+void st7735_fill_rects(St7735Lcd *lcd, const St7735Rect *rects, int count,
+                       uint16_t color);
+
+// 1-pixel outlines of several boxes in one batched fill (4 edges each)
+void st7735_draw_rect_outlines(St7735Lcd *lcd, const St7735Rect *rects,
+                               int count, uint16_t color);
+
 void st7735_draw_char(St7735Lcd *lcd, int x, int y, char c, uint16_t fg,
                       uint16_t bg, uint8_t size);
 
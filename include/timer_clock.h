@@ -0,0 +1,41 @@
+#pragma once
+
+#include <stdint.h>
+
+// Monotonic clock source for TimerManager: microseconds since an arbitrary
+// origin, never going backwards. The target uses esp_timer; a host build
+// injects a fake it advances by hand
+typedef struct {
+  int64_t (*now_us)(void *ctx);
+  void *ctx;
+} TimerClock;
+
+static inline int64_t timer_clock_now_us(const TimerClock *clock) {
+  return clock->now_us(clock->ctx);
+}
+
+// esp_timer_get_time(): 1 us resolution, independent of the FreeRTOS tick
+const TimerClock *timer_clock_esp_timer(void);
+
+// Fake clock: time moves only through timer_fake_clock_advance_us()
+typedef struct {
+  TimerClock clock;
+  int64_t now_us;
+} TimerFakeClock;
+
+static inline int64_t timer_fake_clock_read(void *ctx) {
+  return ((const TimerFakeClock *)ctx)->now_us;
+}
+
+static inline const TimerClock *timer_fake_clock_init(TimerFakeClock *fake,
+                                                      int64_t start_us) {
+  fake->now_us = start_us;
+  fake->clock.now_us = timer_fake_clock_read;
+  fake->clock.ctx = fake;
+  return &fake->clock;
+}
+
+static inline void timer_fake_clock_advance_us(TimerFakeClock *fake,
+                                               int64_t delta_us) {
+  fake->now_us += delta_us;
+}
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "timer_clock.h"
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 // Delay after reaching zero before broadcasting the null (0xFF) signal
@@ -13,16 +15,55 @@
 // Display is 2-digit: the clock never holds more than 99 seconds
 #define TIMER_MAX_SECONDS 99
 
-// Countdown state in milliseconds: stop preserves the exact remaining
-// time (officials expect stop/start to keep the fraction of a second)
+// Below this the clock is shown (TFT and radio) in deciseconds
+#define TIMER_TENTHS_WINDOW_MS 5000
+
+// Timers held by one manager: the play clock plus court clocks (game,
+// period) run from the same controller
+#define TIMER_MAX_TIMERS 4
+#define TIMER_PLAY 0    // the play/shot clock; the single-timer API drives it
+#define TIMER_NONE 0xFF // no timer (link leader, failed add)
+
+// mm:ss clocks: up to 99:59, seconds and tenths ("59.9") below a minute
+#define TIMER_MAX_MMSS_SECONDS (99 * 60 + 59)
+#define TIMER_MMSS_TENTHS_WINDOW_MS 60000
+
+typedef enum {
+  TIMER_FORMAT_SECONDS = 0, // "24", "4.9" inside TIMER_TENTHS_WINDOW_MS
+  TIMER_FORMAT_MMSS,        // "10:00", "59.9" inside a minute
+} TimerFormat;
+
+// Link rules, follower -> leader (timer_manager_link)
+#define TIMER_LINK_CAP 0x01   // follower never holds more than the leader
+#define TIMER_LINK_STOP 0x02  // stopped with the leader, can't run without it
+#define TIMER_LINK_START 0x04 // started with the leader (unless at zero)
+
+// Per-timer state bits
+#define TIMER_STATE_RUNNING 0x01
+#define TIMER_STATE_ZERO 0x02 // zero reached; zero_reached_us is valid
+
+// Countdown state in microseconds from a TimerClock: stop preserves the
+// exact remaining time (officials expect stop/start to keep the fraction of
+// a second), and the zero crossing is not quantized to the FreeRTOS tick.
+// Struct of arrays indexed by timer id: every timer is advanced in one pass
+// from a single clock read, so they all share one sample instant
 typedef struct {
-  uint32_t remaining_ms;
-  bool is_running;
-  uint32_t last_update_ms;
-  uint32_t zero_reached_timestamp;
+  const TimerClock *clock;
+  uint8_t count;
+  int64_t last_update_us; // remaining_us[] were exact at this clock reading
+  int64_t remaining_us[TIMER_MAX_TIMERS];
+  int64_t zero_reached_us[TIMER_MAX_TIMERS];
+  uint8_t state[TIMER_MAX_TIMERS]; // TIMER_STATE_*
+  uint8_t format[TIMER_MAX_TIMERS];
+  uint8_t link_leader[TIMER_MAX_TIMERS]; // TIMER_NONE = independent
+  uint8_t link_rules[TIMER_MAX_TIMERS];
+  uint8_t radio_channel[TIMER_MAX_TIMERS]; // stream channel in the frames
 } TimerManager;
 
-void timer_manager_init(TimerManager *manager, uint16_t initial_seconds);
+// clock: timer_clock_esp_timer() on target, a TimerFakeClock on the host.
+// Starts with the play clock only (TIMER_FORMAT_SECONDS, stream channel 0)
+void timer_manager_init(TimerManager *manager, uint16_t initial_seconds,
+                        const TimerClock *clock);
 void timer_manager_update(TimerManager *manager);
 void timer_manager_start(TimerManager *manager);
 void timer_manager_stop(TimerManager *manager);
@@ -38,10 +79,54 @@ uint16_t timer_manager_get_seconds(const TimerManager *manager);
 // 0 means less than 100ms left (or expired - check remaining_ms)
 uint16_t timer_manager_get_deciseconds(const TimerManager *manager);
 
+// Rounded up, so it is only 0 once the countdown has really expired
 uint32_t timer_manager_get_remaining_ms(const TimerManager *manager);
+int64_t timer_manager_get_remaining_us(const TimerManager *manager);
+
+// Clock reading at which every get_remaining_us() was exact (last update,
+// start, stop, reset or adjust)
+int64_t timer_manager_get_sample_us(const TimerManager *manager);
 
 // Officials' correction while stopped: shift the clock by delta_ms,
 // clamped to [0, TIMER_MAX_SECONDS]. Ignored while running
 void timer_manager_adjust_ms(TimerManager *manager, int32_t delta_ms);
 
 bool timer_manager_is_running(const TimerManager *manager);
+
+// Microseconds from now until something observable changes on any timer:
+// the displayed value (whole seconds, mm:ss, or tenths) or the play
+// clock's null signal. -1 = nothing will change until the next input
+int64_t timer_manager_next_event_us(const TimerManager *manager);
+
+// -----------------------------------------------------------------------------
+// Court timers (ids other than TIMER_PLAY)
+// -----------------------------------------------------------------------------
+
+// Stopped at `seconds` (clamped to the format's maximum); returns the id or
+// TIMER_NONE when all TIMER_MAX_TIMERS are in use
+uint8_t timer_manager_add(TimerManager *manager, TimerFormat format,
+                          uint16_t seconds, uint8_t radio_channel);
+
+// Drop every timer but TIMER_PLAY (and links to the dropped ones)
+void timer_manager_drop_court_timers(TimerManager *manager);
+
+// follower obeys rules (TIMER_LINK_*) against leader; one leader per
+// follower, applied at once (a CAP takes effect immediately)
+bool timer_manager_link(TimerManager *manager, uint8_t follower,
+                        uint8_t leader, uint8_t rules);
+
+void timer_manager_timer_start(TimerManager *manager, uint8_t id);
+void timer_manager_timer_stop(TimerManager *manager, uint8_t id);
+void timer_manager_timer_reset(TimerManager *manager, uint8_t id,
+                               uint16_t seconds);
+bool timer_manager_timer_is_running(const TimerManager *manager, uint8_t id);
+int64_t timer_manager_timer_remaining_us(const TimerManager *manager,
+                                         uint8_t id);
+TimerFormat timer_manager_timer_format(const TimerManager *manager,
+                                       uint8_t id);
+uint8_t timer_manager_timer_radio_channel(const TimerManager *manager,
+                                          uint8_t id);
+
+// Display text in the timer's format ("24", "4.9", "10:00", "59.9")
+void timer_manager_timer_text(const TimerManager *manager, uint8_t id,
+                              char *buf, size_t len);
@@ -3,16 +3,72 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
 #include "sport_manager.h"
 #include "sport_selector.h"
 #include "st7735_lcd.h"
 
+// Render task: the control loop only posts commands; SPI work happens on
+// its own core so a full redraw never delays buttons, rotary or ESP-NOW
+#define UI_RENDER_QUEUE_LEN 12
+#define UI_RENDER_TASK_STACK 6144
+#define UI_RENDER_TASK_PRIORITY 4
+#define UI_RENDER_TASK_CORE 1
+// A full queue means the render task is wedged or flooded: wait this long,
+// then drop the command (logged) rather than stall the control loop
+#define UI_RENDER_POST_TIMEOUT_MS 20
+// Pixel bytes streamed per render pass before the queue is checked again:
+// ~2 ms on the wire at 26 MHz SPI (25 full-width rows)
+#define UI_RENDER_SLICE_BYTES 6400
+#define UI_CMD_MAX_CHANNELS 8
+
+// What a differential text update last put on screen (big clock), so the
+// next update repaints only the character cells that changed
+typedef struct {
+  char text[8];
+  int x;
+  int y;
+  uint16_t fg;
+  uint16_t bg;
+  uint8_t size;
+  bool valid;
+} UiTextCache;
+
+// Which screen is up and what its menu rows currently show, so a rotary
+// detent repaints only the rows that changed
+typedef enum {
+  UI_SCREEN_NONE = 0, // unknown / being redrawn
+  UI_SCREEN_MAIN,
+  UI_SCREEN_SPORT_MENU,
+  UI_SCREEN_VARIANT_MENU,
+  UI_SCREEN_CHANNEL_MENU
+} UiScreen;
+
+typedef struct {
+  UiScreen screen;
+  const sport_group_t *group; // variant menu: group on screen
+  uint8_t count;              // rows on screen
+  uint8_t selected_idx;
+  uint8_t active_idx;                   // channel menu: '*' row
+  uint8_t bar_len[UI_CMD_MAX_CHANNELS]; // channel menu: occupancy bars
+} UiMenuState;
+
 typedef struct {
   St7735Lcd st7735;
   bool initialized;
+  UiTextCache clock;
+  UiTextCache game_clock; // court game clock line under the big clock
+  UiMenuState menu;
+
+  QueueHandle_t render_queue;
+  TaskHandle_t render_task;
+  volatile uint32_t render_pending; // pixel bytes not yet streamed
 } UiManager;
 
-// Initialize ST7735
+// Initialize ST7735 and start the render task. Every call below only
+// queues a command for that task (redundant ones are coalesced)
 void ui_manager_init_st7735(UiManager *manager, gpio_num_t cs_pin,
                             gpio_num_t dc_pin, gpio_num_t rst_pin,
                             gpio_num_t mosi_pin, gpio_num_t sck_pin);
@@ -33,14 +89,19 @@ void ui_manager_update_display(UiManager *manager, const sport_config_t *sport,
                                uint16_t seconds,
                                const SportManager *sport_manager);
 
+// Menus below repaint only the rows that changed when the same menu is
+// already on screen (selection moved, occupancy bar changed); otherwise
+// they draw the full screen
+
 // Sport selection menu
 void ui_manager_show_sport_menu(UiManager *manager, const sport_group_t *groups,
                                 size_t group_count, uint8_t selected_group_idx);
 
-void ui_st7735_update_sport_menu_selection(UiManager *manager,
-                                           const sport_group_t *groups,
-                                           size_t group_count,
-                                           uint8_t selected_group_idx);
+// Sport menu: move the '>' marker without a full repaint
+void ui_manager_update_sport_menu_selection(UiManager *manager,
+                                            const sport_group_t *groups,
+                                            size_t group_count,
+                                            uint8_t selected_group_idx);
 
 // Variant selection list
 void ui_manager_show_variant_menu(UiManager *manager,
@@ -52,10 +113,31 @@ void ui_manager_show_channel_menu(UiManager *manager, const uint8_t *channels,
                                   const uint16_t *scores, uint8_t count,
                                   uint8_t selected_idx, uint8_t active_idx);
 
+// Court game clock (mm:ss / "59.9") on a line under the big clock, running
+// screen only; "" clears the line. Differential like the big clock
+void ui_manager_update_game_clock(UiManager *manager, const char *text);
+
 // Small RUN/PAUSE + TX-brightness + radio-link status row (running screen
 // only); brightness_pct is the profile applied to the transmitted RGB
 void ui_manager_draw_status(UiManager *manager, bool running, bool link_good,
                             uint8_t brightness_pct);
 
+// Red one-line alert in the header row (e.g. "RADIO FAILED"); stays until
+// the next full-screen draw
+void ui_manager_show_alert(UiManager *manager, const char *text);
+
+// Render work still outstanding: commands waiting in the queue plus pixel
+// bytes drawn but not yet streamed to the panel
+void ui_manager_get_render_backlog(const UiManager *manager,
+                                   uint32_t *queued_commands,
+                                   uint32_t *pending_bytes);
+
 void ui_manager_clear(UiManager *manager);
 void ui_manager_run_display_tests(UiManager *manager);
+
+// Render every screen once (main, time/tenths updates, status, all three
+// menus) and log SPI commands/bytes/windows/transactions, wall time and the
+// framebuffer checksum per operation. Leaves the channel menu on screen -
+// the caller redraws whatever it needs next
+void ui_manager_run_render_benchmark(UiManager *manager,
+                                     const SportManager *sport_manager);
@@ -0,0 +1,61 @@
+#include "channel_migrator.h"
+#include <string.h>
+
+void channel_migrator_init(ChannelMigrator *m,
+                           const ChannelMigratorConfig *cfg) {
+  memset(m, 0, sizeof(*m));
+  m->cfg = cfg ? *cfg : CHANNEL_MIGRATOR_CONFIG_DEFAULT;
+}
+
+void channel_migrator_note_change(ChannelMigrator *m, uint32_t now_ms) {
+  m->changed = true;
+  m->last_change_ms = now_ms;
+  m->degraded = false;
+}
+
+static bool channel_migrator_is_degraded(const ChannelMigrator *m,
+                                         const ChannelMigratorInput *in) {
+  if (in->busy_pct[in->active_idx] >= m->cfg.busy_pct)
+    return true;
+  return in->success_pct >= 0 && in->success_pct < m->cfg.success_pct;
+}
+
+int channel_migrator_step(ChannelMigrator *m, const ChannelMigratorInput *in,
+                          uint32_t now_ms) {
+  if (in->count < 2 || in->active_idx >= in->count)
+    return -1;
+
+  // Any clean observation restarts the hold: a flapping channel never
+  // accumulates HOLD_MS of degradation
+  if (!channel_migrator_is_degraded(m, in)) {
+    m->degraded = false;
+    return -1;
+  }
+  if (!m->degraded) {
+    m->degraded = true;
+    m->degraded_since_ms = now_ms;
+  }
+  if (now_ms - m->degraded_since_ms < m->cfg.hold_ms)
+    return -1;
+  if (m->changed && now_ms - m->last_change_ms < m->cfg.min_interval_ms)
+    return -1;
+
+  // Quietest other candidate (first wins a tie: the list is in preference
+  // order)
+  int best = -1;
+  for (uint8_t i = 0; i < in->count; i++) {
+    if (i == in->active_idx)
+      continue;
+    if (best < 0 || in->busy_pct[i] < in->busy_pct[best])
+      best = i;
+  }
+
+  // Nowhere clearly better (the whole band is busy): stay, rather than hop
+  // between equally bad channels
+  if (in->busy_pct[best] + m->cfg.margin_pct > in->busy_pct[in->active_idx])
+    return -1;
+
+  channel_migrator_note_change(m, now_ms);
+  m->migrations++;
+  return best;
+}
@@ -1,30 +1,63 @@
 #include "../include/colors.h"
 
-// Seconds remaining below which football switches to the urgent color
-#define URGENT_COUNTDOWN_THRESHOLD_SEC 5
+const uint8_t color_brightness_pct[COLOR_BRIGHTNESS_LEVELS] = {100, 50, 25};
+
+color_lut_entry_t color_lut[COLOR_SCHEME_COUNT][COLOR_LUT_SECONDS]
+                           [COLOR_BRIGHTNESS_LEVELS];
+
+// Per-scheme colors for the three countdown phases. Adding a scheme is a
+// row here; the lookup table picks it up at boot
+typedef struct {
+    color_t normal; // at or above the urgent threshold
+    color_t urgent; // final seconds
+    color_t zero;   // expired
+} scheme_colors_t;
+
+static const scheme_colors_t SCHEME_COLORS[COLOR_SCHEME_COUNT] = {
+    // Football: urgent color inside the final seconds, red at zero
+    [COLOR_SCHEME_FOOTBALL] = {COLOR_ORANGE, COLOR_DEEP_ORANGE, COLOR_RED},
+    // Basketball: always red
+    [COLOR_SCHEME_BASKETBALL] = {COLOR_RED, COLOR_RED, COLOR_RED},
+    // Other sports: always orange
+    [COLOR_SCHEME_BASEBALL] = {COLOR_ORANGE, COLOR_ORANGE, COLOR_ORANGE},
+    [COLOR_SCHEME_VOLLEYBALL] = {COLOR_ORANGE, COLOR_ORANGE, COLOR_ORANGE},
+    [COLOR_SCHEME_LACROSSE] = {COLOR_ORANGE, COLOR_ORANGE, COLOR_ORANGE},
+    [COLOR_SCHEME_CUSTOM] = {COLOR_ORANGE, COLOR_ORANGE, COLOR_ORANGE},
+};
 
 color_t get_sport_color(color_scheme_t scheme, uint8_t seconds) {
-    switch (scheme) {
-        case COLOR_SCHEME_FOOTBALL:
-            // Football: urgent color inside the final seconds, red at zero
-            if (seconds == 0xFF || seconds == 0) {
-                return COLOR_RED;
-            } else if (seconds < URGENT_COUNTDOWN_THRESHOLD_SEC) {
-                return COLOR_DEEP_ORANGE;
-            } else {
-                return COLOR_ORANGE;
+    if (scheme >= COLOR_SCHEME_COUNT) {
+        scheme = COLOR_SCHEME_CUSTOM;
+    }
+
+    const scheme_colors_t *sc = &SCHEME_COLORS[scheme];
+    if (seconds == 0xFF || seconds == 0) {
+        return sc->zero;
+    } else if (seconds < URGENT_COUNTDOWN_THRESHOLD_SEC) {
+        return sc->urgent;
+    } else {
+        return sc->normal;
+    }
+}
+
+void colors_init(void) {
+    for (int s = 0; s < COLOR_SCHEME_COUNT; s++) {
+        for (int sec = 0; sec < COLOR_LUT_SECONDS; sec++) {
+            color_t base = get_sport_color((color_scheme_t)s, (uint8_t)sec);
+
+            for (int b = 0; b < COLOR_BRIGHTNESS_LEVELS; b++) {
+                uint8_t pct = color_brightness_pct[b];
+                color_t c = {
+                    (uint8_t)((base.r * pct) / 100),
+                    (uint8_t)((base.g * pct) / 100),
+                    (uint8_t)((base.b * pct) / 100),
+                };
+                uint16_t rgb565 = ((c.r & 0xF8) << 8) | ((c.g & 0xFC) << 3) |
+                                  (c.b >> 3);
+
+                color_lut[s][sec][b].rgb = c;
+                color_lut[s][sec][b].rgb565_be = __builtin_bswap16(rgb565);
             }
-            
-        case COLOR_SCHEME_BASKETBALL:
-            // Basketball: always red
-            return COLOR_RED;
-            
-        case COLOR_SCHEME_BASEBALL:
-        case COLOR_SCHEME_VOLLEYBALL:
-        case COLOR_SCHEME_LACROSSE:
-        case COLOR_SCHEME_CUSTOM:
-        default:
-            // Other sports: always orange
-            return COLOR_ORANGE;
+        }
     }
-}
\ No newline at end of file
+}
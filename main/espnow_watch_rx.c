@@ -8,6 +8,7 @@
 #include "esp_wifi.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
+#include "main_events.h"
 #include "nvs_flash.h"
 #include <string.h>
 
@@ -61,7 +62,9 @@ static void espnow_recv_cb(const esp_now_recv_info_t *info,
   uint8_t command = cmd.command;
   if (xQueueSend(cmd_queue, &command, 0) != pdTRUE) {
     ESP_LOGW(TAG, "Command queue full - dropped");
+    return;
   }
+  main_events_post(MAIN_EVT_WATCH);
 }
 
 bool espnow_watch_rx_init(void) {
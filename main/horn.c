@@ -0,0 +1,139 @@
+#include "horn.h"
+#include "esp_log.h"
+#include <string.h>
+
+static const char *TAG = "HORN";
+
+#define US_PER_MS 1000
+
+// -----------------------------------------------------------------------------
+// TIMER CALLBACKS
+//  - Run in the esp_timer task (priority 22, core 0), which preempts the
+//    control loop on the same core: a callback never interleaves with
+//    horn_schedule(). The report is handed over with release/acquire
+// -----------------------------------------------------------------------------
+static void horn_set(const Horn *horn, bool on) {
+  if (horn->pin != GPIO_NUM_NC)
+    gpio_set_level(horn->pin, on ? 1 : 0);
+}
+
+static void horn_arm_next(Horn *horn) {
+  int64_t at = horn->warn_at_us ? horn->warn_at_us : horn->zero_at_us;
+  if (!at)
+    return;
+
+  int64_t delay = at - esp_timer_get_time();
+  esp_timer_start_once(horn->event_timer, delay > 0 ? (uint64_t)delay : 0);
+}
+
+static void horn_off_cb(void *arg) { horn_set((Horn *)arg, false); }
+
+static void horn_event_cb(void *arg) {
+  Horn *horn = (Horn *)arg;
+  HornEvent event;
+  int64_t target;
+  uint32_t blast_ms;
+
+  if (horn->warn_at_us) {
+    event = HORN_EVENT_WARN;
+    target = horn->warn_at_us;
+    blast_ms = HORN_WARN_MS;
+    horn->warn_at_us = 0;
+  } else if (horn->zero_at_us) {
+    event = HORN_EVENT_ZERO;
+    target = horn->zero_at_us;
+    blast_ms = HORN_ZERO_MS;
+    horn->zero_at_us = 0;
+  } else {
+    return;
+  }
+
+  horn_set(horn, true);
+  int64_t fired = esp_timer_get_time();
+  esp_timer_stop(horn->off_timer);
+  esp_timer_start_once(horn->off_timer, (uint64_t)blast_ms * US_PER_MS);
+
+  horn->report.event = event;
+  horn->report.target_us = target;
+  horn->report.fired_us = fired;
+  __atomic_store_n(&horn->report_pending, true, __ATOMIC_RELEASE);
+
+  horn_arm_next(horn);
+}
+
+// -----------------------------------------------------------------------------
+// PUBLIC API
+// -----------------------------------------------------------------------------
+bool horn_init(Horn *horn, gpio_num_t pin) {
+  memset(horn, 0, sizeof(Horn));
+  horn->pin = pin;
+
+  if (pin != GPIO_NUM_NC) {
+    // Pull-down keeps the driver off from configuration on (the pin floats
+    // through reset until then: use a driver that is off when undriven)
+    gpio_config_t conf = {.pin_bit_mask = (1ULL << pin),
+                          .mode = GPIO_MODE_OUTPUT,
+                          .pull_up_en = GPIO_PULLUP_DISABLE,
+                          .pull_down_en = GPIO_PULLDOWN_ENABLE,
+                          .intr_type = GPIO_INTR_DISABLE};
+    gpio_config(&conf);
+    gpio_set_level(pin, 0);
+  }
+
+  esp_timer_create_args_t event_args = {
+      .callback = horn_event_cb,
+      .arg = horn,
+      .dispatch_method = ESP_TIMER_TASK,
+      .name = "horn_event",
+  };
+  esp_timer_create_args_t off_args = {
+      .callback = horn_off_cb,
+      .arg = horn,
+      .dispatch_method = ESP_TIMER_TASK,
+      .name = "horn_off",
+  };
+  if (esp_timer_create(&event_args, &horn->event_timer) != ESP_OK ||
+      esp_timer_create(&off_args, &horn->off_timer) != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to create horn timers");
+    return false;
+  }
+
+  horn->initialized = true;
+  ESP_LOGI(TAG, "Horn on GPIO%d", pin);
+  return true;
+}
+
+void horn_schedule(Horn *horn, bool running, int64_t remaining_us,
+                   int64_t sample_us, bool warn_at_10) {
+  if (!horn->initialized)
+    return;
+
+  esp_timer_stop(horn->event_timer);
+  horn->warn_at_us = 0;
+  horn->zero_at_us = 0;
+
+  if (!running || remaining_us <= 0)
+    return;
+
+  horn->zero_at_us = sample_us + remaining_us;
+  if (warn_at_10 && remaining_us > (int64_t)HORN_WARN_AT_MS * US_PER_MS)
+    horn->warn_at_us = horn->zero_at_us - (int64_t)HORN_WARN_AT_MS * US_PER_MS;
+
+  horn_arm_next(horn);
+}
+
+void horn_log_report(Horn *horn) {
+  if (!__atomic_load_n(&horn->report_pending, __ATOMIC_ACQUIRE))
+    return;
+
+  HornReport r = horn->report;
+  __atomic_store_n(&horn->report_pending, false, __ATOMIC_RELAXED);
+
+  int64_t late = r.fired_us - r.target_us;
+  if (late > horn->max_late_us)
+    horn->max_late_us = late;
+
+  ESP_LOGI(TAG, "%s horn %+lld us from the clock crossing (max %lld us)",
+           r.event == HORN_EVENT_ZERO ? "Zero" : "10s warning",
+           (long long)late, (long long)horn->max_late_us);
+}
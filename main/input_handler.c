@@ -1,7 +1,9 @@
 #include "input_handler.h"
+#include "esp_attr.h"
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "main_events.h"
 #include <string.h>
 
 #define DOUBLE_TAP_MS 500
@@ -12,6 +14,22 @@
 
 static const char *TAG = "INPUT_HANDLER";
 
+// -----------------------------------------------------------------------------
+// EDGE WAKE
+//  - Any edge on any input pin wakes the control loop, which then polls as
+//    before (debounce and gestures stay in the poll path). GPIO36/39 can
+//    glitch when WiFi starts (ESP32 errata): that only costs a spare poll
+// -----------------------------------------------------------------------------
+static void IRAM_ATTR input_edge_isr(void *arg) {
+  main_events_post_from_isr(MAIN_EVT_INPUT);
+}
+
+static void input_enable_edge_wake(gpio_num_t pin) {
+  gpio_set_intr_type(pin, GPIO_INTR_ANYEDGE);
+  if (gpio_isr_handler_add(pin, input_edge_isr, NULL) != ESP_OK)
+    ESP_LOGW(TAG, "No edge wake on GPIO%d - polled on other wake-ups", pin);
+}
+
 // -----------------------------------------------------------------------------
 // INIT
 // -----------------------------------------------------------------------------
@@ -45,6 +63,19 @@ void input_handler_init(InputHandler *h, gpio_num_t control_pin,
   h->press_count = 0;
   h->last_consumed_position = 0;
 
+  // Shared ISR service: the radio IRQ may have installed it already
+  esp_err_t err = gpio_install_isr_service(ESP_INTR_FLAG_IRAM);
+  if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+    ESP_LOGW(TAG, "GPIO ISR service unavailable (%d)", err);
+  } else {
+    const gpio_num_t pins[] = {control_pin, clk_pin,     dt_pin,
+                               sw_pin,      preset1_pin, preset2_pin,
+                               preset3_pin, preset4_pin, start_pin,
+                               reset_pin};
+    for (size_t i = 0; i < sizeof(pins) / sizeof(pins[0]); i++)
+      input_enable_edge_wake(pins[i]);
+  }
+
   ESP_LOGI(TAG, "InputHandler initialized");
 }
 
@@ -203,3 +234,31 @@ InputAction input_handler_update(InputHandler *h, SportManager *sport_mgr,
 
   return action;
 }
+
+// -----------------------------------------------------------------------------
+// SETTLED
+// -----------------------------------------------------------------------------
+static bool button_is_debouncing(const Button *b) {
+  ButtonState raw = b->current_level ? BUTTON_RELEASED : BUTTON_PRESSED;
+  return raw != b->state;
+}
+
+bool input_handler_is_settled(const InputHandler *h) {
+  if (button_is_debouncing(&h->control_button) ||
+      button_is_debouncing(&h->start_button) ||
+      button_is_debouncing(&h->reset_button))
+    return false;
+  for (int i = 0; i < 4; i++) {
+    if (button_is_debouncing(&h->preset_buttons[i]))
+      return false;
+  }
+
+  // Hold-to-reset and the double-tap window are timed, not edge-driven
+  if (h->button_active || h->press_count > 0)
+    return false;
+
+  // Rotary backlog drains one detent per poll
+  int32_t delta = h->rotary_encoder.position - h->last_consumed_position;
+  return delta < ROTARY_COUNTS_PER_DETENT &&
+         delta > -ROTARY_COUNTS_PER_DETENT;
+}
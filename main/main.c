@@ -5,8 +5,13 @@
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "horn.h"
 #include "input_handler.h"
+#include "main_events.h"
 #include "radio_comm.h"
+#include "radio_frame.h"
+#include "radio_tx_task.h"
+#include "resume_state.h"
 #include "rotary_encoder.h"
 #include "sport_manager.h"
 #include "sport_selector.h"
@@ -15,6 +20,7 @@
 #include "ui_manager.h"
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 static const char *TAG = "CONTROLLER";
 
@@ -24,6 +30,7 @@ static const char *TAG = "CONTROLLER";
 #define CONTROL_BUTTON_PIN GPIO_NUM_0
 #define NRF24_CE_PIN GPIO_NUM_5
 #define NRF24_CSN_PIN GPIO_NUM_4
+#define NRF24_IRQ_PIN GPIO_NUM_17 // GPIO_NUM_NC if not wired: STATUS is polled
 
 #define ST7735_CS_PIN GPIO_NUM_27
 #define ST7735_DC_PIN GPIO_NUM_26
@@ -33,7 +40,7 @@ static const char *TAG = "CONTROLLER";
 
 // Rotary encoder pins
 #define ROTARY_CLK_PIN GPIO_NUM_33
-#define ROTARY_DT_PIN GPIO_NUM_16
+#define ROTARY_DT_PIN GPIO_NUM_39 // input-only: the KY-040 pull-up holds it
 #define ROTARY_SW_PIN GPIO_NUM_32
 
 // External buttons
@@ -44,31 +51,38 @@ static const char *TAG = "CONTROLLER";
 #define BTN_START_PIN GPIO_NUM_35
 #define BTN_RESET_PIN GPIO_NUM_15
 
-// Timing
-#define RADIO_TRANSMIT_INTERVAL_MS 250
-#define MAIN_LOOP_DELAY_MS 50
+// Horn / active buzzer driver (GPIO_NUM_NC: no horn, timing still logged).
+// Not a strapping pin, so the horn driver can't upset the boot mode
+#define HORN_PIN GPIO_NUM_16
+
+// Log per-screen SPI cost + framebuffer checksums once at boot (render
+// optimisation work / regression check against known-good checksums)
+#define UI_BENCHMARK_AT_BOOT 0
+
+// Log display error of legacy vs clock frames at 0-50% simulated packet
+// loss once at boot, including legacy displays hearing extended frames
+// (radio_frame_loss_benchmark, no radio involved)
+#define RADIO_FRAME_BENCHMARK_AT_BOOT 0
+#define RADIO_FRAME_BENCHMARK_SEEDS 8
+
+// Log wake-ups per source this often (event loop regression check)
+#define MAIN_EVENTS_STATS_INTERVAL_MS 10000
 
 // Boot-time radio init retries
 #define RADIO_INIT_ATTEMPTS 3
 #define RADIO_INIT_RETRY_DELAY_MS 1000
 
-// Re-configure the radio after this many consecutive TX failures (~5s at 4Hz)
-#define RADIO_CONSEC_FAIL_LIMIT 20
-
 // -----------------------------------------------------------------------------
 // Globals
 // -----------------------------------------------------------------------------
 static RadioComm radio;
-static uint8_t sequence = 0;
-
-// TX brightness profiles, cycled by rotary click on the running screen.
-// Applied to the RGB carried in the frame - receivers just render what
-// they get, so no protocol or receiver change is involved
-static const uint8_t BRIGHTNESS_PCT[] = {100, 50, 25};
-#define BRIGHTNESS_LEVELS (sizeof(BRIGHTNESS_PCT) / sizeof(BRIGHTNESS_PCT[0]))
+static RadioTx radio_tx; // owns the radio once started
 
 typedef struct {
-  uint32_t radio_last_transmit;
+  // TX brightness profile (index into color_brightness_pct), cycled by rotary
+  // click on the running screen. Applied to the RGB carried in the frame -
+  // receivers just render what they get, so no protocol or receiver change
+  // is involved
   uint8_t brightness_idx;
   uint8_t channel_menu_idx;
 } MainState;
@@ -76,7 +90,8 @@ typedef struct {
 static MainState main_state = {0};
 
 // Channel agility: candidate list shared with receivers via radio_config.h;
-// scores refreshed at boot and whenever the channel menu opens
+// scores come from a blocking survey at boot, then from the TX task's
+// background sampling (refreshed whenever the channel menu is drawn)
 static const uint8_t CHANNEL_CANDIDATES[] = RADIO_CHANNEL_CANDIDATES;
 static uint16_t channel_scores[RADIO_CHANNEL_CANDIDATE_COUNT];
 
@@ -88,8 +103,9 @@ static uint8_t channel_index_of(uint8_t channel) {
   return 0;
 }
 
-// Survey every candidate (~250ms); restores the active channel afterwards.
-// The next radio_send_time() re-enters TX mode itself
+// Survey every candidate (~250ms, boot only - before the TX task owns the
+// radio); restores the active channel and TX mode afterwards (the survey
+// leaves the chip in RX)
 static void survey_channels(RadioComm *r) {
   for (uint8_t i = 0; i < RADIO_CHANNEL_CANDIDATE_COUNT; i++) {
     channel_scores[i] = radio_common_survey_channel(
@@ -97,17 +113,188 @@ static void survey_channels(RadioComm *r) {
     ESP_LOGI(TAG, "Survey: channel %u busy %u/%u", CHANNEL_CANDIDATES[i],
              channel_scores[i], RADIO_SURVEY_SAMPLES);
   }
-  radio_common_set_channel(&r->base, r->base.channel);
+  radio_set_channel(r, r->base.channel);
+}
+
+static void refresh_channel_scores(bool radio_ok) {
+  if (radio_ok)
+    radio_tx_get_channel_scores(&radio_tx, channel_scores);
+}
+
+#if RADIO_FRAME_BENCHMARK_AT_BOOT
+// Per loss level, summed over RADIO_FRAME_BENCHMARK_SEEDS runs: share of
+// time a display showed the wrong value, mean and max error
+static void run_frame_loss_benchmark(void) {
+  // Replayed at the cadence the TX task airs at (started with the defaults)
+  const RadioTxPolicy policy = RADIO_TX_POLICY_DEFAULT;
+  const RadioFrameLossCadence cadence = {
+      .active_keepalive_ms = policy.active_keepalive_ms,
+      .idle_keepalive_ms = policy.idle_keepalive_ms,
+      .epoch_fast_ms = RADIO_TX_EPOCH_FAST_MS,
+  };
+
+  for (uint8_t loss = 0; loss <= 50; loss += 10) {
+    uint32_t sim_ms = 0, legacy_wrong = 0, mixed_wrong = 0, clock_wrong = 0;
+    uint32_t legacy_max = 0, clock_max = 0;
+    uint64_t legacy_sum = 0, clock_sum = 0;
+
+    for (uint32_t seed = 1; seed <= RADIO_FRAME_BENCHMARK_SEEDS; seed++) {
+      RadioFrameLossResult r;
+      radio_frame_loss_benchmark(&cadence, loss, seed * 2654435761u, &r);
+      sim_ms += r.sim_ms;
+      legacy_wrong += r.legacy_wrong_ms;
+      mixed_wrong += r.mixed_wrong_ms;
+      clock_wrong += r.clock_wrong_ms;
+      legacy_sum += r.legacy_err_sum_ms;
+      clock_sum += r.clock_err_sum_ms;
+      if (r.legacy_max_err_ms > legacy_max)
+        legacy_max = r.legacy_max_err_ms;
+      if (r.clock_max_err_ms > clock_max)
+        clock_max = r.clock_max_err_ms;
+    }
+
+    uint32_t steps = sim_ms / 10;
+    ESP_LOGI(TAG,
+             "Frame loss %u%%: legacy wrong %.1f%% mean %lu ms max %lu ms | "
+             "clock wrong %.1f%% mean %lu ms max %lu ms | legacy with "
+             "extended frames wrong %.1f%%",
+             loss, legacy_wrong * 100.0f / sim_ms,
+             (unsigned long)(legacy_sum / steps), (unsigned long)legacy_max,
+             clock_wrong * 100.0f / sim_ms,
+             (unsigned long)(clock_sum / steps), (unsigned long)clock_max,
+             mixed_wrong * 100.0f / sim_ms);
+  }
+}
+#endif
+
+// Bring the radio up and hand it to the TX task. survey: boot-time noise
+// survey picks the channel; otherwise stay on `channel` (resume)
+static bool start_radio(bool survey, uint8_t channel) {
+  // Retry: a transient SPI glitch at power-up must not leave the operator
+  // with a silently dead controller
+  bool radio_ok = false;
+  for (int attempt = 1; attempt <= RADIO_INIT_ATTEMPTS; attempt++) {
+    radio_ok = radio_begin(&radio, NRF24_CE_PIN, NRF24_CSN_PIN, NRF24_IRQ_PIN);
+    if (radio_ok)
+      break;
+    ESP_LOGW(TAG, "Radio init attempt %d/%d failed, retrying...", attempt,
+             RADIO_INIT_ATTEMPTS);
+    vTaskDelay(pdMS_TO_TICKS(RADIO_INIT_RETRY_DELAY_MS));
+  }
+  if (!radio_ok)
+    return false;
+
+  if (survey) {
+    // Venue noise survey: pick the quietest candidate before the first TX.
+    // Receivers find us by scanning the same list
+    survey_channels(&radio);
+    uint8_t best = 0;
+    for (uint8_t i = 1; i < RADIO_CHANNEL_CANDIDATE_COUNT; i++) {
+      if (channel_scores[i] < channel_scores[best])
+        best = i;
+    }
+    channel = CHANNEL_CANDIDATES[best];
+    ESP_LOGI(TAG, "Auto-picked channel %u (busy %u/%u)", channel,
+             channel_scores[best], RADIO_SURVEY_SAMPLES);
+  }
+  radio_set_channel(&radio, channel);
+
+  if (!radio_tx_start(&radio_tx, &radio, NULL)) {
+    ESP_LOGE(TAG, "Radio TX task failed - continuing without radio");
+    return false;
+  }
+  if (survey)
+    radio_tx_seed_channel_scores(&radio_tx, channel_scores);
+  return true;
+}
+
+// Hand the clock state to the TX task, which airs each new value at its
+// exact boundary and keeps the policy's keep-alive. Returns whether it
+// carried the null signal
+static bool publish_clock(const TimerManager *timer_mgr,
+                          const sport_config_t *sport) {
+  RadioClockSnapshot snap = {
+      .remaining_us = (uint32_t)timer_manager_get_remaining_us(timer_mgr),
+      .taken_us = timer_manager_get_sample_us(timer_mgr),
+      .running = timer_manager_is_running(timer_mgr),
+      // 3s after reaching zero, broadcast the null signal so displays
+      // clear
+      .send_null = timer_manager_should_send_null(timer_mgr),
+      .warn_at_10 = sport->warn_at_10,
+      .color_scheme = sport->color_scheme,
+      .brightness_idx = main_state.brightness_idx,
+  };
+  for (uint8_t id = 1; id < timer_mgr->count; id++) {
+    snap.court[snap.court_count++] = (RadioTimerSnapshot){
+        .remaining_us = timer_manager_timer_remaining_us(timer_mgr, id),
+        .running = timer_manager_timer_is_running(timer_mgr, id),
+        .mmss = timer_manager_timer_format(timer_mgr, id) == TIMER_FORMAT_MMSS,
+        .channel = timer_manager_timer_radio_channel(timer_mgr, id),
+    };
+  }
+  radio_tx_publish(&radio_tx, &snap);
+  return snap.send_null;
+}
+
+// -----------------------------------------------------------------------------
+// COURT TIMERS
+//  - Sports with a game clock run it as a second TimerManager timer
+//    (mm:ss, stream channel COURT_GAME_CLOCK_CHANNEL). The play clock is
+//    linked to it: never above it, stopped with it, started with it
+// -----------------------------------------------------------------------------
+#define COURT_GAME_CLOCK_CHANNEL 1
+
+static uint8_t court_game_clock(const TimerManager *timer_mgr) {
+  return timer_mgr->count > 1 ? 1 : TIMER_NONE;
+}
+
+// Keeps a running game clock across presets and variant changes; only a
+// sport without one drops it
+static void configure_court_timers(TimerManager *timer_mgr,
+                                   const sport_config_t *sport) {
+  if (sport->game_clock_seconds == 0) {
+    timer_manager_drop_court_timers(timer_mgr);
+    return;
+  }
+  if (court_game_clock(timer_mgr) != TIMER_NONE)
+    return;
+
+  uint8_t game = timer_manager_add(timer_mgr, TIMER_FORMAT_MMSS,
+                                   sport->game_clock_seconds,
+                                   COURT_GAME_CLOCK_CHANNEL);
+  timer_manager_link(timer_mgr, TIMER_PLAY, game,
+                     TIMER_LINK_CAP | TIMER_LINK_STOP | TIMER_LINK_START);
+  ESP_LOGI(TAG, "Game clock %u:%02u on stream channel %u",
+           sport->game_clock_seconds / 60, sport->game_clock_seconds % 60,
+           COURT_GAME_CLOCK_CHANNEL);
+}
+
+// START/STOP with a game clock: the whistle stops both, the next START
+// restarts both; while the game clock runs, START on a stopped play clock
+// (new possession after a reset) restarts just the play clock
+static void court_start_stop(TimerManager *timer_mgr) {
+  uint8_t game = court_game_clock(timer_mgr);
+  if (game == TIMER_NONE) {
+    timer_manager_start_stop(timer_mgr);
+  } else if (!timer_manager_timer_is_running(timer_mgr, game)) {
+    timer_manager_timer_start(timer_mgr, game);
+  } else if (!timer_manager_is_running(timer_mgr)) {
+    timer_manager_start(timer_mgr);
+  } else {
+    timer_manager_timer_stop(timer_mgr, game);
+  }
 }
 
 // Common sequence after a sport change or reset request: stop the timer,
 // re-read the active sport, reset the countdown and redraw the display.
+// A running game clock is not touched
 static void apply_current_sport_and_reset(TimerManager *timer_mgr,
                                           UiManager *ui_mgr,
                                           SportManager *sport_mgr,
                                           sport_config_t *current_sport) {
   timer_manager_stop(timer_mgr);
   *current_sport = sport_manager_get_current_sport(sport_mgr);
+  configure_court_timers(timer_mgr, current_sport);
   timer_manager_reset(timer_mgr, current_sport->play_clock_seconds);
   ui_manager_update_display(ui_mgr, current_sport,
                             timer_manager_get_seconds(timer_mgr), sport_mgr);
@@ -120,18 +307,47 @@ void app_main(void) {
 
   ESP_LOGI(TAG, "Starting Controller Application");
 
+  // Before any wake source (GPIO edges, watch uplink, TX task) can post
+  if (!main_events_init()) {
+    ESP_LOGE(TAG, "Event loop init failed!");
+    return;
+  }
+
   SportManager sport_mgr;
   TimerManager timer_mgr;
   UiManager ui_mgr;
   InputHandler input_handler;
+  Horn horn;
 
+  colors_init();
   sport_manager_init(&sport_mgr);
 
-  // Boot into sport menu
-  sport_manager_enter_sport_menu(&sport_mgr);
+  // A reset mid-game (panic, watchdog, brown-out) resumes where it left
+  // off; any other boot starts in the sport menu
+  ResumeState resume;
+  bool resumed = resume_state_load(&resume, timer_clock_esp_timer());
+  bool radio_ok = false;
 
-  sport_config_t initial_sport = sport_manager_get_current_sport(&sport_mgr);
-  timer_manager_init(&timer_mgr, initial_sport.play_clock_seconds);
+  if (resumed) {
+    sport_manager_set_sport(&sport_mgr, resume.sport);
+    timer_mgr = resume.timer;
+    main_state.brightness_idx = resume.brightness_idx % COLOR_BRIGHTNESS_LEVELS;
+
+    // Radio before anything slow (display init): previous channel, no
+    // survey (unless the radio was down then), the restored clock aired as
+    // soon as the TX task runs
+    radio_ok = start_radio(resume.channel == 0, resume.channel);
+    if (radio_ok) {
+      sport_config_t sport = sport_manager_get_current_sport(&sport_mgr);
+      publish_clock(&timer_mgr, &sport);
+    }
+  } else {
+    sport_manager_enter_sport_menu(&sport_mgr);
+
+    sport_config_t initial_sport = sport_manager_get_current_sport(&sport_mgr);
+    timer_manager_init(&timer_mgr, initial_sport.play_clock_seconds,
+                       timer_clock_esp_timer());
+  }
 
   // Input handler
   input_handler_init(&input_handler, CONTROL_BUTTON_PIN, ROTARY_CLK_PIN,
@@ -139,6 +355,11 @@ void app_main(void) {
                      BTN_PRESET2_PIN, BTN_PRESET3_PIN, BTN_PRESET4_PIN,
                      BTN_START_PIN, BTN_RESET_PIN);
 
+  // Non-fatal: the clock and the remote displays work without it
+  if (!horn_init(&horn, HORN_PIN)) {
+    ESP_LOGW(TAG, "Horn unavailable - continuing without it");
+  }
+
   ui_manager_init_st7735(&ui_mgr, ST7735_CS_PIN, ST7735_DC_PIN, ST7735_RST_PIN,
                          ST7735_SDA_PIN, ST7735_SCL_PIN);
 
@@ -147,50 +368,36 @@ void app_main(void) {
     return;
   }
 
-  // Initial sport menu draw
-  {
+#if UI_BENCHMARK_AT_BOOT
+  ui_manager_run_render_benchmark(&ui_mgr, &sport_mgr);
+#endif
+#if RADIO_FRAME_BENCHMARK_AT_BOOT
+  run_frame_loss_benchmark();
+#endif
+
+  if (resumed) {
+    // Straight back to the running screen
+    sport_config_t sport = sport_manager_get_current_sport(&sport_mgr);
+    ui_manager_update_display(&ui_mgr, &sport,
+                              timer_manager_get_seconds(&timer_mgr),
+                              &sport_mgr);
+  } else {
+    // Initial sport menu draw
     size_t group_count;
     const sport_group_t *groups = sport_manager_get_groups(&group_count);
 
     ui_manager_show_sport_menu(
         &ui_mgr, groups, group_count,
         sport_manager_get_current_group_index(&sport_mgr));
-  }
 
-  // Radio initialization (retry: a transient SPI glitch at power-up must
-  // not leave the operator with a silently dead controller)
-  bool radio_ok = false;
-  for (int attempt = 1; attempt <= RADIO_INIT_ATTEMPTS; attempt++) {
-    radio_ok = radio_begin(&radio, NRF24_CE_PIN, NRF24_CSN_PIN);
-    if (radio_ok)
-      break;
-    ESP_LOGW(TAG, "Radio init attempt %d/%d failed, retrying...", attempt,
-             RADIO_INIT_ATTEMPTS);
-    vTaskDelay(pdMS_TO_TICKS(RADIO_INIT_RETRY_DELAY_MS));
+    radio_ok = start_radio(true, 0);
   }
 
-  if (radio_ok) {
-    // Venue noise survey: pick the quietest candidate before the first TX.
-    // Receivers find us by scanning the same list
-    survey_channels(&radio);
-    uint8_t best = 0;
-    for (uint8_t i = 1; i < RADIO_CHANNEL_CANDIDATE_COUNT; i++) {
-      if (channel_scores[i] < channel_scores[best])
-        best = i;
-    }
-    radio_common_set_channel(&radio.base, CHANNEL_CANDIDATES[best]);
-    ESP_LOGI(TAG, "Auto-picked channel %u (busy %u/%u)",
-             CHANNEL_CANDIDATES[best], channel_scores[best],
-             RADIO_SURVEY_SAMPLES);
-
-    nrf24_power_up(&radio.base);
-    nrf24_write_register(&radio.base, NRF24_REG_CONFIG, RADIO_CONFIG_TX_MODE);
-  } else {
+  if (!radio_ok) {
     // The timer stays usable locally; make the dead radio visible on the
     // TFT instead of silently returning from app_main
     ESP_LOGE(TAG, "Radio init failed - continuing without radio");
-    st7735_print(&ui_mgr.st7735, 8, 4, st7735_color565(255, 0, 0),
-                 ST7735_BLACK, 1, "RADIO FAILED");
+    ui_manager_show_alert(&ui_mgr, "RADIO FAILED");
   }
 
   // Referee watch uplink (ESP-NOW on the otherwise idle WiFi radio).
@@ -203,12 +410,17 @@ void app_main(void) {
   ESP_LOGI(TAG, "Controller initialized");
 
   uint16_t last_time = 65535;
-  uint16_t last_sent_value = 65535;
-  uint16_t consecutive_tx_failures = 0;
   int last_status = -1; // encoded RUN/link glyph state; -1 forces a redraw
+  bool null_published = false;
+  bool last_running = false;
+  char last_game_text[8] = ""; // game clock line on the TFT; "" = none
+  int saved_channel = -1;      // channel in the resume snapshot; -1 = none
+  uint32_t stats_ticks = xTaskGetTickCount();
 
   // -------------------------------------------------------------------------
   // MAIN LOOP
+  //  - Runs once per wake-up: an input edge, a watch command, a radio link
+  //    flip, or the clock's next visible change (main_events_wait)
   // -------------------------------------------------------------------------
   while (1) {
 
@@ -243,7 +455,7 @@ void app_main(void) {
     // *********************************************************************
     case INPUT_ACTION_START_STOP:
       if (ui_state == SPORT_UI_STATE_RUNNING)
-        timer_manager_start_stop(&timer_mgr);
+        court_start_stop(&timer_mgr);
       break;
 
     // *********************************************************************
@@ -251,9 +463,8 @@ void app_main(void) {
     // *********************************************************************
     case INPUT_ACTION_CHANNEL_MENU:
       if (ui_state == SPORT_UI_STATE_SELECT_SPORT) {
-        if (radio_ok) {
-          survey_channels(&radio);
-        }
+        // Live scores from background sampling: no blocking survey here
+        refresh_channel_scores(radio_ok);
         main_state.channel_menu_idx = channel_index_of(radio.base.channel);
         sport_manager_enter_channel_menu(&sport_mgr);
         ui_manager_show_channel_menu(&ui_mgr, CHANNEL_CANDIDATES,
@@ -290,11 +501,11 @@ void app_main(void) {
     // *********************************************************************
     case INPUT_ACTION_BRIGHTNESS_CYCLE:
       main_state.brightness_idx =
-          (main_state.brightness_idx + 1) % BRIGHTNESS_LEVELS;
+          (main_state.brightness_idx + 1) % COLOR_BRIGHTNESS_LEVELS;
       ESP_LOGI(TAG, "TX brightness: %u%%",
-               BRIGHTNESS_PCT[main_state.brightness_idx]);
-      // Status row redraws below (action != NONE); next 250ms tick
-      // carries the rescaled color
+               color_brightness_pct[main_state.brightness_idx]);
+      // Status row redraws below (action != NONE); the TX task airs the
+      // rescaled color as soon as the snapshot below is published
       break;
 
     // *********************************************************************
@@ -302,6 +513,15 @@ void app_main(void) {
     // *********************************************************************
     case INPUT_ACTION_RESET:
       if (ui_state == SPORT_UI_STATE_RUNNING) {
+        // A game clock that ran out ended the period: RESET sets up the
+        // next one
+        uint8_t game = court_game_clock(&timer_mgr);
+        if (game != TIMER_NONE &&
+            timer_manager_timer_remaining_us(&timer_mgr, game) == 0) {
+          timer_manager_timer_stop(&timer_mgr, game);
+          timer_manager_timer_reset(&timer_mgr, game,
+                                    current_sport.game_clock_seconds);
+        }
         apply_current_sport_and_reset(&timer_mgr, &ui_mgr, &sport_mgr,
                                       &current_sport);
       }
@@ -341,6 +561,9 @@ void app_main(void) {
 
       if (ui_state == SPORT_UI_STATE_RUNNING) {
 
+        // Leaving the court screen is never live play: the game clock
+        // stops too (and the play clock with it)
+        timer_manager_timer_stop(&timer_mgr, court_game_clock(&timer_mgr));
         timer_manager_stop(&timer_mgr);
 
         sport_manager_enter_sport_menu(&sport_mgr);
@@ -385,7 +608,7 @@ void app_main(void) {
         while (sport_manager_get_current_group_index(&sport_mgr) != target)
           sport_manager_next_sport(&sport_mgr);
 
-        ui_st7735_update_sport_menu_selection(
+        ui_manager_update_sport_menu_selection(
             &ui_mgr, groups, group_count,
             sport_manager_get_current_group_index(&sport_mgr));
 
@@ -408,6 +631,7 @@ void app_main(void) {
                 : (uint8_t)(idx == 0 ? RADIO_CHANNEL_CANDIDATE_COUNT - 1
                                      : idx - 1);
 
+        refresh_channel_scores(radio_ok);
         ui_manager_show_channel_menu(&ui_mgr, CHANNEL_CANDIDATES,
                                      channel_scores,
                                      RADIO_CHANNEL_CANDIDATE_COUNT,
@@ -444,15 +668,13 @@ void app_main(void) {
 
       else if (ui_state == SPORT_UI_STATE_CHANNEL_MENU) {
 
-        // Apply the picked channel; receivers re-acquire by scanning the
-        // candidate list within a few seconds. The clock is NOT reset -
-        // a channel change must never wipe game state
+        // Apply the picked channel: the TX task hops (after ~1s of
+        // announcements when extended frames are on, so following receivers
+        // re-acquire within one tick; legacy ones find it by scanning). The
+        // clock is NOT reset - a channel change must never wipe game state
         if (radio_ok) {
-          radio_common_set_channel(
-              &radio.base, CHANNEL_CANDIDATES[main_state.channel_menu_idx]);
-          nrf24_power_up(&radio.base);
-          nrf24_write_register(&radio.base, NRF24_REG_CONFIG,
-                               RADIO_CONFIG_TX_MODE);
+          radio_tx_request_channel(
+              &radio_tx, CHANNEL_CANDIDATES[main_state.channel_menu_idx]);
         }
 
         sport_manager_exit_menu(&sport_mgr);
@@ -471,6 +693,22 @@ void app_main(void) {
     // =====================================================================
     timer_manager_update(&timer_mgr);
 
+    // =====================================================================
+    // HORN
+    //  - Re-armed whenever the clock may have jumped (start, stop, adjust,
+    //    reset, preset) or stopped on its own; the blasts themselves fire
+    //    from esp_timer at the crossing instant, not from this loop
+    // =====================================================================
+    bool running = timer_manager_is_running(&timer_mgr);
+    bool clock_changed = action != INPUT_ACTION_NONE || running != last_running;
+    if (clock_changed) {
+      horn_schedule(&horn, running, timer_manager_get_remaining_us(&timer_mgr),
+                    timer_manager_get_sample_us(&timer_mgr),
+                    current_sport.warn_at_10);
+      last_running = running;
+    }
+    horn_log_report(&horn);
+
     uint16_t now = timer_manager_get_seconds(&timer_mgr);
 
     // Final 5 seconds (running or paused): time is handled in deciseconds
@@ -478,7 +716,7 @@ void app_main(void) {
     // window shows the exact restart value (stop at 3.4 displays 3.4)
     uint32_t rem_ms = timer_manager_get_remaining_ms(&timer_mgr);
     uint16_t ds = timer_manager_get_deciseconds(&timer_mgr);
-    bool tenths_mode = rem_ms > 0 && rem_ms < 5000;
+    bool tenths_mode = rem_ms > 0 && rem_ms < TIMER_TENTHS_WINDOW_MS;
 
     // Track the displayed value: whole seconds normally, 1000+ds in the
     // tenths window (disjoint ranges, so transitions always redraw)
@@ -507,7 +745,7 @@ void app_main(void) {
       if (status_now != last_status || action != INPUT_ACTION_NONE) {
         ui_manager_draw_status(&ui_mgr, timer_manager_is_running(&timer_mgr),
                                radio_ok && radio.link_good,
-                               BRIGHTNESS_PCT[main_state.brightness_idx]);
+                               color_brightness_pct[main_state.brightness_idx]);
         last_status = status_now;
       }
     } else {
@@ -515,63 +753,79 @@ void app_main(void) {
     }
 
     // =====================================================================
-    // RADIO UPDATE
+    // GAME CLOCK LINE — running screen only, redrawn on change or after
+    // any action (full redraws wipe it)
     // =====================================================================
-    uint32_t t = xTaskGetTickCount() * portTICK_PERIOD_MS;
-
-    // Carried time value: deciseconds encoding (256+d) inside the tenths
-    // window, whole seconds otherwise; bit 15 flags the 10s buzzer for
-    // sports that use it (football)
-    uint16_t tx_value =
-        tenths_mode ? (uint16_t)(RADIO_TIME_DECISECONDS_BASE + ds) : now;
-    if (current_sport.warn_at_10) {
-      tx_value |= RADIO_TIME_FLAG_WARN10;
-    }
-
-    // Force an immediate broadcast when the carried value changes so remote
-    // displays track the controller within one loop iteration instead of
-    // lagging up to a full 250 ms transmit interval (in tenths mode this
-    // fires every decisecond: ~10 Hz)
-    if (tx_value != last_sent_value) {
-      main_state.radio_last_transmit = 0;
+    if (sport_manager_get_ui_state(&sport_mgr) == SPORT_UI_STATE_RUNNING) {
+      char game_text[8] = "";
+      uint8_t game = court_game_clock(&timer_mgr);
+      if (game != TIMER_NONE)
+        timer_manager_timer_text(&timer_mgr, game, game_text,
+                                 sizeof(game_text));
+      if (strcmp(game_text, last_game_text) != 0 ||
+          (action != INPUT_ACTION_NONE && game_text[0] != '\0')) {
+        ui_manager_update_game_clock(&ui_mgr, game_text);
+        strcpy(last_game_text, game_text);
+      }
+    } else {
+      last_game_text[0] = '\0';
     }
 
-    if (radio_ok &&
-        t - main_state.radio_last_transmit >= RADIO_TRANSMIT_INTERVAL_MS) {
-
-      uint16_t sec = tx_value;
-      // Color follows whole seconds in both modes (4.9s gets the <5s color)
-      color_t c = get_sport_color(current_sport.color_scheme,
-                                  tenths_mode ? ds / 10 : now);
-
-      // Apply the TX brightness profile to the carried color
-      uint8_t pct = BRIGHTNESS_PCT[main_state.brightness_idx];
-      c.r = (uint8_t)((c.r * pct) / 100);
-      c.g = (uint8_t)((c.g * pct) / 100);
-      c.b = (uint8_t)((c.b * pct) / 100);
-
-      // 3s after reaching zero, broadcast the null signal so displays clear
-      if (timer_manager_should_send_null(&timer_mgr)) {
-        sec = TIMER_NULL_SIGNAL;
-      }
+    // =====================================================================
+    // RADIO UPDATE
+    //  - Only publishes the clock state: the radio TX task airs each new
+    //    value at its exact boundary and keeps the policy's keep-alive
+    // =====================================================================
+    if (radio_ok)
+      null_published = publish_clock(&timer_mgr, &current_sport);
 
-      if (radio_send_time(&radio, sec, c.r, c.g, c.b, sequence++)) {
-        consecutive_tx_failures = 0;
-      } else if (++consecutive_tx_failures >= RADIO_CONSEC_FAIL_LIMIT) {
-        // Sustained failures suggest a wedged chip, not RF conditions:
-        // re-configure it (never restart - the timer must survive)
-        radio_recover(&radio);
-        consecutive_tx_failures = 0;
+    // =====================================================================
+    // RESUME SNAPSHOT
+    //  - Rewritten after anything a reset must not lose; between changes the
+    //    RTC clock carries the countdown
+    //  - Clock screen only: a resume always lands there, so a reset in a
+    //    menu (clock stopped, selection half made) boots into the sport
+    //    menu instead
+    // =====================================================================
+    int channel = radio_ok ? radio.base.channel : 0;
+    if (sport_manager_get_ui_state(&sport_mgr) != SPORT_UI_STATE_RUNNING) {
+      if (saved_channel >= 0) {
+        resume_state_clear();
+        saved_channel = -1;
       }
-
-      main_state.radio_last_transmit = t;
-      last_sent_value = tx_value;
+    } else if (clock_changed || channel != saved_channel) {
+      resume_state_save(&timer_mgr, current_sport.sport,
+                        main_state.brightness_idx, (uint8_t)channel);
+      saved_channel = channel;
     }
 
-    if (radio_ok) {
-      radio_update_link_status(&radio);
+    // =====================================================================
+    // SLEEP UNTIL THE NEXT EVENT
+    // =====================================================================
+    int64_t wait_us = timer_manager_next_event_us(&timer_mgr);
+    if (!input_handler_is_settled(&input_handler) &&
+        (wait_us < 0 || wait_us > INPUT_ACTIVE_POLL_MS * 1000))
+      wait_us = INPUT_ACTIVE_POLL_MS * 1000;
+    // An action may leave more queued (rotary backlog, a second watch
+    // command); the null signal may have come due since the snapshot
+    if (action != INPUT_ACTION_NONE ||
+        (radio_ok && !null_published &&
+         timer_manager_should_send_null(&timer_mgr)))
+      wait_us = 0;
+
+    main_events_wait(wait_us);
+
+    if (xTaskGetTickCount() - stats_ticks >=
+        pdMS_TO_TICKS(MAIN_EVENTS_STATS_INTERVAL_MS)) {
+      MainEventStats st;
+      main_events_take_stats(&st);
+      ESP_LOGI(TAG,
+               "Wakes %lu: input %lu, watch %lu, link %lu, deadline %lu, "
+               "timeout %lu",
+               (unsigned long)st.wakes, (unsigned long)st.input,
+               (unsigned long)st.watch, (unsigned long)st.link,
+               (unsigned long)st.deadline, (unsigned long)st.timeout);
+      stats_ticks = xTaskGetTickCount();
     }
-
-    vTaskDelay(pdMS_TO_TICKS(MAIN_LOOP_DELAY_MS));
   }
 }
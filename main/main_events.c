@@ -0,0 +1,83 @@
+#include "main_events.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <string.h>
+
+static const char *TAG = "MAIN_EVENTS";
+
+static TaskHandle_t loop_task;
+static esp_timer_handle_t deadline_timer;
+static MainEventStats stats;
+
+static void main_events_deadline_cb(void *arg) {
+  main_events_post(MAIN_EVT_DEADLINE);
+}
+
+bool main_events_init(void) {
+  esp_timer_create_args_t timer_args = {
+      .callback = main_events_deadline_cb,
+      .dispatch_method = ESP_TIMER_TASK,
+      .name = "main_deadline",
+  };
+  if (esp_timer_create(&timer_args, &deadline_timer) != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to create deadline timer");
+    return false;
+  }
+
+  loop_task = xTaskGetCurrentTaskHandle();
+  return true;
+}
+
+void main_events_post(uint32_t bits) {
+  TaskHandle_t task = loop_task;
+  if (task)
+    xTaskNotify(task, bits, eSetBits);
+}
+
+void IRAM_ATTR main_events_post_from_isr(uint32_t bits) {
+  TaskHandle_t task = loop_task;
+  if (task) {
+    BaseType_t woken = pdFALSE;
+    xTaskNotifyFromISR(task, bits, eSetBits, &woken);
+    portYIELD_FROM_ISR(woken);
+  }
+}
+
+uint32_t main_events_wait(int64_t delay_us) {
+  uint32_t bits = 0;
+
+  // Events that arrived while the loop was busy end the wait at once
+  if (delay_us == 0) {
+    xTaskNotifyWait(0, UINT32_MAX, &bits, 0);
+    stats.wakes++;
+    return bits;
+  }
+
+  esp_timer_stop(deadline_timer);
+  if (delay_us > 0 && delay_us < (int64_t)MAIN_EVENTS_MAX_SLEEP_MS * 1000)
+    esp_timer_start_once(deadline_timer, (uint64_t)delay_us);
+
+  if (xTaskNotifyWait(0, UINT32_MAX, &bits,
+                      pdMS_TO_TICKS(MAIN_EVENTS_MAX_SLEEP_MS)) != pdTRUE) {
+    stats.timeout++;
+  }
+
+  stats.wakes++;
+  if (bits & MAIN_EVT_INPUT)
+    stats.input++;
+  if (bits & MAIN_EVT_WATCH)
+    stats.watch++;
+  if (bits & MAIN_EVT_LINK)
+    stats.link++;
+  if (bits & MAIN_EVT_DEADLINE)
+    stats.deadline++;
+  return bits;
+}
+
+void main_events_take_stats(MainEventStats *out) {
+  *out = stats;
+  memset(&stats, 0, sizeof(stats));
+}
@@ -1,21 +1,331 @@
 #include "radio_comm.h"
 #include "driver/gpio.h"
 #include "driver/spi_master.h"
+#include "esp_attr.h"
 #include "esp_log.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "radio_frame.h"
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
 static const char *TAG = "RADIO_COMM";
 
-bool radio_begin(RadioComm *radio, gpio_num_t ce, gpio_num_t csn) {
+_Static_assert(RADIO_FRAME_SIZE == RADIO_PAYLOAD_SIZE,
+               "radio_frame.h layout out of step with radio_config.h");
+
+// Not exported by radio-common (the receivers never look at the TX FIFO)
+#ifndef NRF24_REG_FIFO_STATUS
+#define NRF24_REG_FIFO_STATUS 0x17
+#endif
+#ifndef NRF24_FIFO_STATUS_TX_EMPTY
+#define NRF24_FIFO_STATUS_TX_EMPTY 0x10
+#endif
+
+// -----------------------------------------------------------------------------
+// TX completion
+//  - The nRF24 pulls IRQ low on TX_DS/MAX_RT (both unmasked in CONFIG); the
+//    ISR only wakes the task waiting on the copy in flight
+//  - The line stays low until STATUS is cleared, so the edge can't be missed
+//    between copies: each copy starts from a released line
+// -----------------------------------------------------------------------------
+static void IRAM_ATTR radio_irq_isr(void *arg) {
+  RadioComm *radio = (RadioComm *)arg;
+  TaskHandle_t waiter = radio->tx_waiter;
+  if (waiter) {
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(waiter, &woken);
+    portYIELD_FROM_ISR(woken);
+  }
+}
+
+static bool radio_irq_init(RadioComm *radio, gpio_num_t irq) {
+  radio->irq_pin = GPIO_NUM_NC;
+  if (irq == GPIO_NUM_NC)
+    return false;
+
+  gpio_config_t irq_conf = {.pin_bit_mask = (1ULL << irq),
+                            .mode = GPIO_MODE_INPUT,
+                            .pull_up_en = GPIO_PULLUP_ENABLE,
+                            .pull_down_en = GPIO_PULLDOWN_DISABLE,
+                            .intr_type = GPIO_INTR_NEGEDGE};
+  gpio_config(&irq_conf);
+
+  // Another driver may already own the shared ISR service
+  esp_err_t err = gpio_install_isr_service(ESP_INTR_FLAG_IRAM);
+  if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+    ESP_LOGW(TAG, "GPIO ISR service unavailable (%d) - polling TX status",
+             err);
+    return false;
+  }
+  if (gpio_isr_handler_add(irq, radio_irq_isr, radio) != ESP_OK) {
+    ESP_LOGW(TAG, "IRQ handler not installed - polling TX status");
+    return false;
+  }
+
+  radio->irq_pin = irq;
+  ESP_LOGI(TAG, "TX completion via IRQ on GPIO%d", irq);
+  return true;
+}
+
+// Call before raising CE: drops a stale wake-up left by an earlier copy that
+// timed out, so the next take only returns for this copy
+static void radio_tx_arm(RadioComm *radio) {
+  if (radio->irq_pin == GPIO_NUM_NC)
+    return;
+  radio->tx_waiter = xTaskGetCurrentTaskHandle();
+  ulTaskNotifyTake(pdTRUE, 0);
+}
+
+// Block until TX_DS or MAX_RT; returns the STATUS bits seen (0 = timeout).
+// STATUS is always read back over SPI, so a spurious edge can't fake a
+// completion
+static uint8_t radio_tx_wait(RadioComm *radio) {
+  const uint8_t done_mask = NRF24_STATUS_TX_DS | NRF24_STATUS_MAX_RT;
+  int64_t deadline = esp_timer_get_time() + RADIO_TRANSMIT_TIMEOUT_MS * 1000;
+  uint8_t status = 0;
+
+  while (1) {
+    status = nrf24_get_status(&radio->base) & done_mask;
+    if (status)
+      break;
+
+    int64_t left_us = deadline - esp_timer_get_time();
+    if (left_us <= 0)
+      break;
+
+    if (radio->irq_pin != GPIO_NUM_NC) {
+      // +1 tick so a sub-tick remainder still waits instead of spinning
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(left_us / 1000) + 1);
+    } else {
+      esp_rom_delay_us(RADIO_TX_POLL_INTERVAL_US);
+    }
+  }
+
+  radio->tx_waiter = NULL;
+  return status;
+}
+
+// -----------------------------------------------------------------------------
+// Register shadow
+//  - Write-through copy of the configuration registers (CONFIG..RF_SETUP);
+//    STATUS and FIFO_STATUS change under us and are never shadowed
+//  - Anything that drives the chip behind our back must invalidate what it
+//    touched: radio-common configure the whole shadow, a survey or channel
+//    change only CONFIG (PRIM_RX) and RF_CH. `powered` outlives the latter,
+//    since neither takes the chip out of power-up
+//  - radio_shadow_verify() re-reads the chip periodically, so a brown-out
+//    that resets the registers is still caught
+// -----------------------------------------------------------------------------
+static void radio_reg_write(RadioComm *radio, uint8_t reg, uint8_t value) {
+  if (reg < RADIO_SHADOW_REGS) {
+    if ((radio->shadow_valid & (1u << reg)) && radio->shadow[reg] == value)
+      return;
+    radio->shadow[reg] = value;
+    radio->shadow_valid |= 1u << reg;
+  }
+  nrf24_write_register(&radio->base, reg, value);
+}
+
+void radio_shadow_invalidate(RadioComm *radio) {
+  radio->shadow_valid = 0;
+  radio->powered = false;
+}
+
+static void radio_shadow_invalidate_rf(RadioComm *radio) {
+  radio->shadow_valid &=
+      ~((1u << NRF24_REG_CONFIG) | (1u << RADIO_SHADOW_REG_RF_CH));
+}
+
+void radio_enter_tx(RadioComm *radio) {
+  const uint8_t tx_config =
+      (RADIO_CONFIG_TX_MODE | NRF24_CONFIG_PWR_UP) & ~NRF24_CONFIG_PRIM_RX;
+
+  bool known = radio->shadow_valid & (1u << NRF24_REG_CONFIG);
+  bool was_powered =
+      known ? (radio->shadow[NRF24_REG_CONFIG] & NRF24_CONFIG_PWR_UP)
+            : radio->powered;
+
+  // Shadow says TX standby already: nothing on the wire, no settle
+  if (known && radio->shadow[NRF24_REG_CONFIG] == tx_config)
+    return;
+
+  radio_reg_write(radio, NRF24_REG_CONFIG, tx_config);
+  radio->powered = true;
+
+  // Power-down -> standby needs the crystal to start (Tpd2stby); an RX -> TX
+  // switch only needs the 130 us PLL settle that CE high already covers
+  if (!was_powered)
+    esp_rom_delay_us(RADIO_PWR_UP_SETTLE_US);
+}
+
+// Compare the shadow with the chip; on a mismatch (brown-out, stray write)
+// re-configure and return to TX. Returns false if the chip had drifted
+static bool radio_shadow_verify(RadioComm *radio) {
+  radio->shadow_verified_ms = xTaskGetTickCount() * portTICK_PERIOD_MS;
+
+  bool intact = radio_common_config_intact(&radio->base);
+  if (intact && (radio->shadow_valid & (1u << NRF24_REG_CONFIG))) {
+    intact = nrf24_read_register(&radio->base, NRF24_REG_CONFIG) ==
+             radio->shadow[NRF24_REG_CONFIG];
+  }
+  if (intact)
+    return true;
+
+  ESP_LOGW(TAG, "Radio registers differ from shadow (brown-out?) - "
+                "re-configuring");
+  radio_common_configure(&radio->base);
+  radio_shadow_invalidate(radio);
+  radio_enter_tx(radio);
+  radio->tx_fifo_dirty = true;
+  return false;
+}
+
+void radio_set_channel(RadioComm *radio, uint8_t channel) {
+  radio_common_set_channel(&radio->base, channel);
+  radio_shadow_invalidate_rf(radio);
+  radio_enter_tx(radio);
+}
+
+// -----------------------------------------------------------------------------
+// Burst modes
+//  - FIFO: all copies preloaded into the 3-deep TX FIFO, CE held high, the
+//    chip airs them back to back (no 130 us PLL settle between copies)
+//  - Spread: one copy at a time with tx_gap_us of silence between them, so
+//    the copies straddle a WiFi burst instead of landing inside the same one
+// -----------------------------------------------------------------------------
+static void radio_tx_sample(uint32_t *sum, uint32_t *max, uint32_t *samples,
+                            int64_t us) {
+  uint32_t v = us < 0 ? 0 : (uint32_t)us;
+  *sum += v;
+  if (v > *max)
+    *max = v;
+  (*samples)++;
+}
+
+// Clear a MAX_RT seen instead of TX_DS (defensive: cannot fire with
+// SETUP_RETR=0, no auto-ACK broadcast)
+static void radio_tx_clear_failure(RadioComm *radio, uint8_t status) {
+  if (status & NRF24_STATUS_MAX_RT)
+    nrf24_write_register(&radio->base, NRF24_REG_STATUS, NRF24_STATUS_MAX_RT);
+}
+
+static uint8_t radio_burst_fifo(RadioComm *radio, const uint8_t *payload,
+                                uint8_t copies) {
+  RadioTxStats *st = &radio->tx_stats;
+
+  gpio_set_level(radio->base.ce_pin, 0);
+  uint8_t loaded = 0;
+  while (loaded < copies && loaded < RADIO_TX_FIFO_DEPTH) {
+    nrf24_write_payload(&radio->base, payload, RADIO_PAYLOAD_SIZE);
+    loaded++;
+  }
+
+  radio_tx_arm(radio);
+  int64_t prev = esp_timer_get_time();
+  gpio_set_level(radio->base.ce_pin, 1);
+
+  uint8_t aired = 0;
+  while (aired < copies) {
+    uint8_t status = radio_tx_wait(radio);
+    if (!(status & NRF24_STATUS_TX_DS)) {
+      // Timeout means a wedged chip - the remaining copies are lost
+      radio_tx_clear_failure(radio, status);
+      break;
+    }
+
+    // Re-arm before clearing: clearing releases IRQ, and the next copy may
+    // complete right after
+    radio_tx_arm(radio);
+    nrf24_write_register(&radio->base, NRF24_REG_STATUS, NRF24_STATUS_TX_DS);
+
+    int64_t now = esp_timer_get_time();
+    radio_tx_sample(&st->airtime_us_sum, &st->airtime_us_max,
+                    &st->airtime_samples, now - prev);
+    prev = now;
+    aired++;
+
+    // TX_DS is a single latch: copies completing before it was cleared show
+    // up as one event, so an empty FIFO is what says the loaded copies are
+    // out (aired may undercount otherwise, which only delays top-ups)
+    if (nrf24_read_register(&radio->base, NRF24_REG_FIFO_STATUS) &
+        NRF24_FIFO_STATUS_TX_EMPTY) {
+      aired = loaded;
+    }
+
+    // Bursts longer than the FIFO: top it up while CE stays high, the chip
+    // picks new copies up without leaving TX
+    while (loaded < copies && loaded - aired < RADIO_TX_FIFO_DEPTH) {
+      nrf24_write_payload(&radio->base, payload, RADIO_PAYLOAD_SIZE);
+      loaded++;
+    }
+  }
+
+  gpio_set_level(radio->base.ce_pin, 0);
+  radio->tx_waiter = NULL;
+  return aired;
+}
+
+static uint8_t radio_burst_spread(RadioComm *radio, const uint8_t *payload,
+                                  uint8_t copies, uint32_t gap_us) {
+  RadioTxStats *st = &radio->tx_stats;
+  int64_t prev_done = 0;
+
+  uint8_t aired = 0;
+  for (uint8_t copy = 0; copy < copies; copy++) {
+    gpio_set_level(radio->base.ce_pin, 0);
+    nrf24_write_payload(&radio->base, payload, RADIO_PAYLOAD_SIZE);
+
+    if (copy > 0) {
+      // Sub-tick gaps spin; longer ones give the CPU away
+      if (gap_us >= portTICK_PERIOD_MS * 1000)
+        vTaskDelay(pdMS_TO_TICKS(gap_us / 1000));
+      else
+        esp_rom_delay_us(gap_us);
+    }
+
+    radio_tx_arm(radio);
+    int64_t start = esp_timer_get_time();
+    gpio_set_level(radio->base.ce_pin, 1);
+
+    // Broadcast, no auto-ACK/retries: TX_DS follows within a few hundred
+    // microseconds (130 us PLL settle + airtime)
+    uint8_t status = radio_tx_wait(radio);
+    gpio_set_level(radio->base.ce_pin, 0);
+    if (!(status & NRF24_STATUS_TX_DS)) {
+      // Timeout means a wedged chip - further copies are pointless
+      radio_tx_clear_failure(radio, status);
+      break;
+    }
+    nrf24_write_register(&radio->base, NRF24_REG_STATUS, NRF24_STATUS_TX_DS);
+
+    int64_t done = esp_timer_get_time();
+    radio_tx_sample(&st->airtime_us_sum, &st->airtime_us_max,
+                    &st->airtime_samples, done - start);
+    if (copy > 0)
+      radio_tx_sample(&st->gap_us_sum, &st->gap_us_max, &st->gap_samples,
+                      start - prev_done);
+    prev_done = done;
+    aired++;
+  }
+
+  return aired;
+}
+
+bool radio_begin(RadioComm *radio, gpio_num_t ce, gpio_num_t csn,
+                 gpio_num_t irq) {
   ESP_LOGI(TAG, "Initializing nRF24L01+ transmitter");
 
   memset(radio, 0, sizeof(RadioComm));
   radio->led_state = false;
   radio->last_log_time = 0;
+  radio->irq_pin = GPIO_NUM_NC;
+  radio->tx_gap_us = RADIO_TX_BURST_GAP_US;
+  radio->tx_copies = RADIO_TX_BURST_COUNT;
 
   // Initialize link status LED
   gpio_config_t led_conf = {.pin_bit_mask = (1ULL << RADIO_STATUS_LED_PIN),
@@ -38,23 +348,138 @@ bool radio_begin(RadioComm *radio, gpio_num_t ce, gpio_num_t csn) {
     return false;
   }
 
-  // Power up the radio and set to TX mode for initial configuration
-  nrf24_power_up(&radio->base);
-  nrf24_write_register(&radio->base, NRF24_REG_CONFIG, RADIO_CONFIG_TX_MODE);
-  vTaskDelay(pdMS_TO_TICKS(2)); // Small delay to ensure mode switch
+  // Power up the radio in TX mode; from here on the shadow tracks CONFIG
+  radio_shadow_invalidate(radio);
+  radio_enter_tx(radio);
+  radio_flush_tx(radio);
 
-  // Ensure radio is powered up and in TX mode
-  nrf24_power_up(&radio->base);
-  uint8_t config = nrf24_read_register(&radio->base, NRF24_REG_CONFIG);
-  config |= NRF24_CONFIG_PWR_UP;   // Ensure PWR_UP is set
-  config &= ~NRF24_CONFIG_PRIM_RX; // Ensure TX mode (PRIM_RX = 0)
-  nrf24_write_register(&radio->base, NRF24_REG_CONFIG, config);
-  vTaskDelay(pdMS_TO_TICKS(2)); // Small delay to ensure mode switch
+  // Clear anything latched during configuration so IRQ starts released
+  nrf24_write_register(&radio->base, NRF24_REG_STATUS,
+                       NRF24_STATUS_TX_DS | NRF24_STATUS_MAX_RT);
+  radio_irq_init(radio, irq);
 
   ESP_LOGI(TAG, "nRF24L01+ transmitter initialized successfully");
   return true;
 }
 
+// -----------------------------------------------------------------------------
+// Link statistics
+//  - One ring entry per tick; the window is defined by time, so a past
+//    outage ages out within RADIO_STATS_WINDOW_MS instead of diluting forever
+// -----------------------------------------------------------------------------
+static void radio_stats_record(RadioComm *radio, bool ok, uint32_t latency_us,
+                               uint32_t now_ms) {
+  RadioTickSample *e = &radio->ring[radio->ring_head];
+  e->time_ms = now_ms;
+  e->latency_us = latency_us;
+  e->ok = ok;
+  radio->ring_head = (radio->ring_head + 1) % RADIO_STATS_RING_LEN;
+  if (radio->ring_count < RADIO_STATS_RING_LEN)
+    radio->ring_count++;
+
+  float x = ok ? 1.0f : 0.0f;
+  if (radio->success_count + radio->failure_count == 0)
+    radio->success_ewma = x;
+  else
+    radio->success_ewma += RADIO_STATS_EWMA_ALPHA * (x - radio->success_ewma);
+}
+
+static int radio_cmp_u32(const void *a, const void *b) {
+  uint32_t x = *(const uint32_t *)a;
+  uint32_t y = *(const uint32_t *)b;
+  return (x > y) - (x < y);
+}
+
+void radio_get_stats(const RadioComm *radio, RadioLinkStats *out) {
+  memset(out, 0, sizeof(*out));
+  out->success_ewma = radio->success_ewma;
+  out->total_ok = radio->success_count;
+  out->total_failed = radio->failure_count;
+
+  uint32_t now_ms = xTaskGetTickCount() * portTICK_PERIOD_MS;
+  uint32_t latencies[RADIO_STATS_RING_LEN];
+  uint16_t n_lat = 0;
+
+  // Walk newest to oldest until the window edge
+  for (uint8_t i = 0; i < radio->ring_count; i++) {
+    uint8_t idx = (radio->ring_head + RADIO_STATS_RING_LEN - 1 - i) %
+                  RADIO_STATS_RING_LEN;
+    const RadioTickSample *e = &radio->ring[idx];
+    if (now_ms - e->time_ms > RADIO_STATS_WINDOW_MS)
+      break;
+    out->window_ticks++;
+    if (e->ok) {
+      out->window_ok++;
+      latencies[n_lat++] = e->latency_us;
+    }
+  }
+
+  if (out->window_ticks > 0)
+    out->success_rate = (float)out->window_ok / out->window_ticks;
+
+  if (n_lat > 0) {
+    qsort(latencies, n_lat, sizeof(latencies[0]), radio_cmp_u32);
+    out->latency_p50_us = latencies[(n_lat - 1) / 2];
+    out->latency_p99_us = latencies[((n_lat - 1) * 99) / 100];
+  }
+}
+
+// One burst of tx_copies identical frames. Returns the copies aired. tick:
+// the time frame a tick is made of; the extended frames riding along in the
+// same tick stay out of the link stats, which count ticks
+static uint8_t radio_send_frame(RadioComm *radio, const uint8_t *payload,
+                                bool tick) {
+  uint32_t current_time = xTaskGetTickCount() * portTICK_PERIOD_MS;
+
+  if (current_time - radio->shadow_verified_ms >=
+      RADIO_SHADOW_VERIFY_INTERVAL_MS) {
+    radio_shadow_verify(radio);
+  }
+
+  // Only a burst that timed out leaves stale copies behind
+  if (radio->tx_fifo_dirty) {
+    radio_flush_tx(radio);
+    radio->tx_fifo_dirty = false;
+  }
+
+  // No-op unless a survey or recovery left the chip out of TX standby
+  radio_enter_tx(radio);
+
+  // Burst: send tx_copies identical copies (same sequence) so at least one
+  // lands in a gap between WiFi bursts. Counters tick once per time frame,
+  // not per copy or per extended frame, so link stats keep measuring ticks
+  uint8_t copies = radio->tx_copies;
+  int64_t burst_start = esp_timer_get_time();
+  uint8_t copies_aired =
+      (radio->tx_gap_us == 0)
+          ? radio_burst_fifo(radio, payload, copies)
+          : radio_burst_spread(radio, payload, copies, radio->tx_gap_us);
+  radio->tx_stats.bursts++;
+  radio->tx_stats.copies_aired += copies_aired;
+  radio->tx_stats.copies_lost += copies - copies_aired;
+  if (copies_aired < copies)
+    radio->tx_fifo_dirty = true;
+  radio->last_burst_us = (uint32_t)(esp_timer_get_time() - burst_start);
+
+  if (!tick)
+    return copies_aired;
+
+  radio_stats_record(radio, copies_aired > 0, radio->last_burst_us,
+                     current_time);
+
+  if (copies_aired > 0) {
+    radio->success_count++;
+    radio->last_success_time = current_time;
+    return copies_aired;
+  }
+
+  radio->failure_count++;
+  radio->last_failure_time = current_time;
+  ESP_LOGW(TAG, "Transmission timeout (failure #%lu)",
+           (unsigned long)radio->failure_count);
+  return 0;
+}
+
 bool radio_send_time(RadioComm *radio, uint16_t seconds, uint8_t r, uint8_t g,
                      uint8_t b, uint8_t sequence) {
   if (!radio || !radio->base.initialized) {
@@ -62,81 +487,67 @@ bool radio_send_time(RadioComm *radio, uint16_t seconds, uint8_t r, uint8_t g,
     return false;
   }
 
-  uint32_t current_time = xTaskGetTickCount() * portTICK_PERIOD_MS;
+  uint8_t payload[RADIO_PAYLOAD_SIZE];
+  radio_frame_encode_time(payload, seconds, r, g, b, sequence);
 
-  // Flush any pending TX data
-  radio_flush_tx(radio);
+  uint8_t copies_aired = radio_send_frame(radio, payload, true);
+  if (copies_aired == 0)
+    return false;
+
+  ESP_LOGI(TAG,
+           "Time sent: %d seconds, RGB(%d,%d,%d), seq: %d, copies: %u/%u "
+           "in %lu us (success #%lu)",
+           seconds, r, g, b, sequence, copies_aired, radio->tx_copies,
+           (unsigned long)radio->last_burst_us,
+           (unsigned long)radio->success_count);
+  return true;
+}
+
+bool radio_send_switch(RadioComm *radio, uint8_t target_channel,
+                       uint8_t switch_sequence, uint8_t sequence) {
+  if (!radio || !radio->base.initialized) {
+    ESP_LOGE(TAG, "Radio not initialized");
+    return false;
+  }
 
-  // Prepare payload - seconds, RGB, and sequence
   uint8_t payload[RADIO_PAYLOAD_SIZE];
-  memset(payload, 0, RADIO_PAYLOAD_SIZE);
-  payload[0] = (seconds >> 8) & 0xFF;
-  payload[1] = seconds & 0xFF;
-  payload[2] = r;
-  payload[3] = g;
-  payload[4] = b;
-  payload[5] = sequence;
-
-  // Set to transmitter mode (clear PRIM_RX bit)
-  uint8_t config = nrf24_read_register(&radio->base, NRF24_REG_CONFIG);
-  config &= ~NRF24_CONFIG_PRIM_RX;
-  nrf24_write_register(&radio->base, NRF24_REG_CONFIG, config);
-  vTaskDelay(pdMS_TO_TICKS(1));
-
-  // Burst: send RADIO_TX_BURST_COUNT identical copies (same sequence) so at
-  // least one lands in a gap between WiFi bursts. Counters tick once per
-  // call, not per copy, so link stats keep measuring ticks
-  uint8_t copies_aired = 0;
-  for (uint8_t copy = 0; copy < RADIO_TX_BURST_COUNT; copy++) {
-    gpio_set_level(radio->base.ce_pin, 0);
-    nrf24_write_payload(&radio->base, payload, RADIO_PAYLOAD_SIZE);
-    gpio_set_level(radio->base.ce_pin, 1);
+  radio_frame_encode_switch(payload, target_channel, switch_sequence,
+                            sequence);
 
-    // Wait for TX_DS (broadcast, no auto-ACK/retries: completes in ~1ms;
-    // the timeout is a safety bound for a wedged chip)
-    bool copy_done = false;
-    uint32_t start_time = xTaskGetTickCount() * portTICK_PERIOD_MS;
-    while ((xTaskGetTickCount() * portTICK_PERIOD_MS) - start_time <
-           RADIO_TRANSMIT_TIMEOUT_MS) {
-      uint8_t status = nrf24_get_status(&radio->base);
-      if (status & NRF24_STATUS_TX_DS) {
-        nrf24_write_register(&radio->base, NRF24_REG_STATUS,
-                             NRF24_STATUS_TX_DS);
-        copy_done = true;
-        break;
-      }
-      if (status & NRF24_STATUS_MAX_RT) {
-        // Defensive: cannot fire with SETUP_RETR=0 (no auto-ACK broadcast)
-        nrf24_write_register(&radio->base, NRF24_REG_STATUS,
-                             NRF24_STATUS_MAX_RT);
-        break;
-      }
-      vTaskDelay(pdMS_TO_TICKS(1));
-    }
+  uint8_t copies_aired = radio_send_frame(radio, payload, false);
+  if (copies_aired == 0)
+    return false;
 
-    gpio_set_level(radio->base.ce_pin, 0);
-    if (!copy_done) {
-      // Timeout means a wedged chip - further copies are pointless
-      break;
-    }
-    copies_aired++;
+  ESP_LOGI(TAG, "Switch announced: channel %u after seq %u, copies: %u/%u",
+           target_channel, switch_sequence, copies_aired, radio->tx_copies);
+  return true;
+}
+
+bool radio_send_clock(RadioComm *radio, uint32_t remaining_ms,
+                      uint8_t clock_flags, uint8_t epoch, uint8_t sequence) {
+  if (!radio || !radio->base.initialized) {
+    ESP_LOGE(TAG, "Radio not initialized");
+    return false;
   }
 
-  if (copies_aired > 0) {
-    radio->success_count++;
-    radio->last_success_time = current_time;
-    ESP_LOGI(TAG,
-             "Time sent: %d seconds, RGB(%d,%d,%d), seq: %d, copies: %u/%u "
-             "(success #%d)",
-             seconds, r, g, b, sequence, copies_aired, RADIO_TX_BURST_COUNT,
-             radio->success_count);
-    return true;
+  uint8_t payload[RADIO_PAYLOAD_SIZE];
+  radio_frame_encode_clock(payload, remaining_ms, clock_flags, epoch,
+                           sequence);
+  return radio_send_frame(radio, payload, false) > 0;
+}
+
+bool radio_send_timer(RadioComm *radio, uint8_t timer_channel,
+                      uint32_t remaining_ms, uint8_t clock_flags,
+                      uint8_t epoch, uint8_t sequence) {
+  if (!radio || !radio->base.initialized) {
+    ESP_LOGE(TAG, "Radio not initialized");
+    return false;
   }
 
-  radio->failure_count++;
-  radio->last_failure_time = current_time;
-  ESP_LOGW(TAG, "Transmission timeout (failure #%d)", radio->failure_count);
-  return false;
+  uint8_t payload[RADIO_PAYLOAD_SIZE];
+  radio_frame_encode_timer(payload, timer_channel, remaining_ms, clock_flags,
+                           epoch, sequence);
+  return radio_send_frame(radio, payload, false) > 0;
 }
 
 bool radio_recover(RadioComm *radio) {
@@ -149,16 +560,36 @@ bool radio_recover(RadioComm *radio) {
   }
 
   ESP_LOGW(TAG, "Re-configuring radio after sustained TX failures");
+  radio_shadow_invalidate(radio);
   if (!radio_common_configure(&radio->base)) {
     return false;
   }
 
-  nrf24_power_up(&radio->base);
-  nrf24_write_register(&radio->base, NRF24_REG_CONFIG, RADIO_CONFIG_TX_MODE);
-  vTaskDelay(pdMS_TO_TICKS(2));
+  radio_enter_tx(radio);
+  radio->tx_fifo_dirty = true;
   return true;
 }
 
+void radio_set_burst_gap_us(RadioComm *radio, uint32_t gap_us) {
+  radio->tx_gap_us = gap_us;
+}
+
+void radio_set_burst_copies(RadioComm *radio, uint8_t copies) {
+  if (copies < 1)
+    copies = 1;
+  if (copies > RADIO_TX_BURST_MAX)
+    copies = RADIO_TX_BURST_MAX;
+  radio->tx_copies = copies;
+}
+
+void radio_get_tx_stats(const RadioComm *radio, RadioTxStats *out) {
+  *out = radio->tx_stats;
+}
+
+void radio_reset_tx_stats(RadioComm *radio) {
+  memset(&radio->tx_stats, 0, sizeof(radio->tx_stats));
+}
+
 bool radio_is_transmit_complete(RadioComm *radio) {
   uint8_t status = nrf24_get_status(&radio->base);
   return (status & (NRF24_STATUS_TX_DS | NRF24_STATUS_MAX_RT)) != 0;
@@ -187,15 +618,12 @@ void radio_update_link_status(RadioComm *radio) {
   bool recent_failure =
       (current_time - radio->last_failure_time) < RADIO_LINK_FAILURE_WINDOW_MS;
 
-  // Determine link quality
-  if (radio->success_count == 0) {
-    radio->link_good = false;
-  } else {
-    uint16_t total_attempts = radio->success_count + radio->failure_count;
-    float success_rate = (float)radio->success_count / total_attempts;
-    radio->link_good =
-        success_rate > RADIO_LINK_SUCCESS_RATE_THRESHOLD && recent_success;
-  }
+  // Determine link quality from the last few seconds only
+  RadioLinkStats stats;
+  radio_get_stats(radio, &stats);
+  radio->link_good = stats.window_ticks > 0 &&
+                     stats.success_rate > RADIO_LINK_SUCCESS_RATE_THRESHOLD &&
+                     recent_success;
 
   // Update LED based on link status
   if (radio->link_good) {
@@ -211,18 +639,41 @@ void radio_update_link_status(RadioComm *radio) {
   // Log link status periodically
   if (current_time - radio->last_log_time > RADIO_LINK_LOG_INTERVAL_MS) {
     radio->last_log_time = current_time;
-    if (radio->success_count + radio->failure_count > 0) {
-      float success_rate = (float)radio->success_count /
-                           (radio->success_count + radio->failure_count) *
-                           100.0f;
-      ESP_LOGI(
-          TAG,
-          "Link Status: %s | Success Rate: %.1f%% | Success: %d, Failures: %d",
-          radio->link_good ? "GOOD" : "POOR", success_rate,
-          radio->success_count, radio->failure_count);
+    if (stats.window_ticks > 0) {
+      ESP_LOGI(TAG,
+               "Link Status: %s | Last %us: %.1f%% (%u/%u) EWMA %.1f%% | "
+               "burst p50 %lu us p99 %lu us | Total: %lu ok, %lu failed",
+               radio->link_good ? "GOOD" : "POOR",
+               RADIO_STATS_WINDOW_MS / 1000, stats.success_rate * 100.0f,
+               stats.window_ok, stats.window_ticks,
+               stats.success_ewma * 100.0f,
+               (unsigned long)stats.latency_p50_us,
+               (unsigned long)stats.latency_p99_us,
+               (unsigned long)stats.total_ok,
+               (unsigned long)stats.total_failed);
+    } else if (stats.total_ok + stats.total_failed > 0) {
+      ESP_LOGI(TAG, "Link Status: POOR | no ticks in the last %us",
+               RADIO_STATS_WINDOW_MS / 1000);
     } else {
       ESP_LOGI(TAG, "Link Status: NO TRANSMISSIONS YET");
     }
+
+    const RadioTxStats *st = &radio->tx_stats;
+    if (st->bursts > 0) {
+      ESP_LOGI(TAG,
+               "TX copies: %lu aired, %lu lost over %lu bursts | airtime "
+               "avg %lu max %lu us | gap avg %lu max %lu us (gap %lu us)",
+               (unsigned long)st->copies_aired,
+               (unsigned long)st->copies_lost, (unsigned long)st->bursts,
+               (unsigned long)(st->airtime_samples
+                                   ? st->airtime_us_sum / st->airtime_samples
+                                   : 0),
+               (unsigned long)st->airtime_us_max,
+               (unsigned long)(st->gap_samples
+                                   ? st->gap_us_sum / st->gap_samples
+                                   : 0),
+               (unsigned long)st->gap_us_max, (unsigned long)radio->tx_gap_us);
+    }
   }
 }
 
@@ -0,0 +1,336 @@
+#include "radio_frame.h"
+#include "../../radio-common/include/radio_config.h"
+#include <string.h>
+
+// Ties the announcement fields together: a corrupted marker byte alone
+// cannot turn a time frame into a hop
+static uint8_t radio_frame_switch_check(uint8_t target, uint8_t switch_seq) {
+  return (uint8_t)(target ^ switch_seq ^ 0xA5);
+}
+
+void radio_frame_encode_time(uint8_t *out, uint16_t time_value, uint8_t r,
+                             uint8_t g, uint8_t b, uint8_t sequence) {
+  out[0] = (time_value >> 8) & 0xFF;
+  out[1] = time_value & 0xFF;
+  out[2] = r;
+  out[3] = g;
+  out[4] = b;
+  out[5] = sequence;
+}
+
+void radio_frame_encode_switch(uint8_t *out, uint8_t target_channel,
+                               uint8_t switch_sequence, uint8_t sequence) {
+  out[0] = RADIO_FRAME_MARKER_SWITCH;
+  out[1] = target_channel;
+  out[2] = switch_sequence;
+  out[3] = radio_frame_switch_check(target_channel, switch_sequence);
+  out[4] = 0;
+  out[5] = sequence;
+}
+
+void radio_frame_encode_clock(uint8_t *out, uint32_t remaining_ms,
+                              uint8_t clock_flags, uint8_t epoch,
+                              uint8_t sequence) {
+  if (remaining_ms > RADIO_FRAME_CLOCK_MAX_MS)
+    remaining_ms = RADIO_FRAME_CLOCK_MAX_MS;
+  out[0] = RADIO_FRAME_MARKER_CLOCK;
+  out[1] = (uint8_t)((RADIO_FRAME_CLOCK_VERSION << 6) |
+                     (clock_flags & (RADIO_FRAME_CLOCK_RUNNING |
+                                     RADIO_FRAME_CLOCK_WARN10 |
+                                     RADIO_FRAME_CLOCK_NULL)) |
+                     (epoch & RADIO_FRAME_CLOCK_EPOCH_MASK));
+  out[2] = (remaining_ms >> 16) & 0xFF;
+  out[3] = (remaining_ms >> 8) & 0xFF;
+  out[4] = remaining_ms & 0xFF;
+  out[5] = sequence;
+}
+
+void radio_frame_encode_timer(uint8_t *out, uint8_t timer_channel,
+                              uint32_t remaining_ms, uint8_t clock_flags,
+                              uint8_t epoch, uint8_t sequence) {
+  if (timer_channel == 0) {
+    radio_frame_encode_clock(out, remaining_ms, clock_flags, epoch, sequence);
+    return;
+  }
+
+  if (remaining_ms > RADIO_FRAME_CLOCK_MAX_MS)
+    remaining_ms = RADIO_FRAME_CLOCK_MAX_MS;
+  out[0] = RADIO_FRAME_MARKER_TIMER;
+  out[1] = (uint8_t)(((timer_channel & 0x03) << 6) |
+                     (clock_flags & (RADIO_FRAME_CLOCK_RUNNING |
+                                     RADIO_FRAME_CLOCK_MMSS |
+                                     RADIO_FRAME_CLOCK_NULL)) |
+                     (epoch & RADIO_FRAME_CLOCK_EPOCH_MASK));
+  out[2] = (remaining_ms >> 16) & 0xFF;
+  out[3] = (remaining_ms >> 8) & 0xFF;
+  out[4] = remaining_ms & 0xFF;
+  out[5] = sequence;
+}
+
+radio_frame_type_t radio_frame_decode(const uint8_t *in, RadioFrame *out) {
+  memset(out, 0, sizeof(*out));
+  out->sequence = in[5];
+
+  if (in[0] == RADIO_FRAME_MARKER_CLOCK) {
+    if ((in[1] >> 6) != RADIO_FRAME_CLOCK_VERSION)
+      return out->type = RADIO_FRAME_INVALID;
+    out->clock_flags = in[1] & (RADIO_FRAME_CLOCK_RUNNING |
+                                RADIO_FRAME_CLOCK_WARN10 |
+                                RADIO_FRAME_CLOCK_NULL);
+    out->epoch = in[1] & RADIO_FRAME_CLOCK_EPOCH_MASK;
+    out->remaining_ms =
+        ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 8) | in[4];
+    return out->type = RADIO_FRAME_CLOCK;
+  }
+
+  if (in[0] == RADIO_FRAME_MARKER_TIMER) {
+    if ((in[1] >> 6) == 0)
+      return out->type = RADIO_FRAME_INVALID;
+    out->timer_channel = in[1] >> 6;
+    out->clock_flags = in[1] & (RADIO_FRAME_CLOCK_RUNNING |
+                                RADIO_FRAME_CLOCK_MMSS |
+                                RADIO_FRAME_CLOCK_NULL);
+    out->epoch = in[1] & RADIO_FRAME_CLOCK_EPOCH_MASK;
+    out->remaining_ms =
+        ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 8) | in[4];
+    return out->type = RADIO_FRAME_CLOCK;
+  }
+
+  if (in[0] == RADIO_FRAME_MARKER_SWITCH) {
+    if (in[3] != radio_frame_switch_check(in[1], in[2]) || in[4] != 0)
+      return out->type = RADIO_FRAME_INVALID;
+    out->target_channel = in[1];
+    out->switch_sequence = in[2];
+    return out->type = RADIO_FRAME_SWITCH;
+  }
+
+  out->time_value = (uint16_t)((in[0] << 8) | in[1]);
+  out->r = in[2];
+  out->g = in[3];
+  out->b = in[4];
+  return out->type = RADIO_FRAME_TIME;
+}
+
+// -----------------------------------------------------------------------------
+// Reference receiver
+// -----------------------------------------------------------------------------
+void radio_frame_rx_init(RadioFrameRx *rx, uint8_t channel) {
+  memset(rx, 0, sizeof(*rx));
+  rx->channel = channel;
+}
+
+static bool radio_frame_rx_hop(RadioFrameRx *rx) {
+  rx->channel = rx->target_channel;
+  rx->switch_pending = false;
+  return true;
+}
+
+bool radio_frame_rx_feed(RadioFrameRx *rx, const RadioFrame *frame,
+                         uint32_t now_ms) {
+  if (frame->type == RADIO_FRAME_SWITCH &&
+      frame->target_channel != rx->channel) {
+    if (!rx->switch_pending)
+      rx->pending_since_ms = now_ms;
+    rx->switch_pending = true;
+    rx->target_channel = frame->target_channel;
+    rx->switch_sequence = frame->switch_sequence;
+  }
+
+  if (!rx->switch_pending || frame->type == RADIO_FRAME_INVALID)
+    return false;
+
+  // Frame N itself, or anything after it (N was lost): the controller has
+  // moved on. Sequences wrap, so compare as a signed distance
+  if ((int8_t)(frame->sequence - rx->switch_sequence) >= 0)
+    return radio_frame_rx_hop(rx);
+  return radio_frame_rx_poll(rx, now_ms);
+}
+
+bool radio_frame_rx_poll(RadioFrameRx *rx, uint32_t now_ms) {
+  if (rx->switch_pending &&
+      now_ms - rx->pending_since_ms >= RADIO_SWITCH_HOP_TIMEOUT_MS)
+    return radio_frame_rx_hop(rx);
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+// Free-running display
+// -----------------------------------------------------------------------------
+void radio_clock_rx_init(RadioClockRx *rx, uint8_t timer_channel) {
+  memset(rx, 0, sizeof(*rx));
+  rx->timer_channel = timer_channel;
+}
+
+uint32_t radio_clock_rx_remaining_ms(const RadioClockRx *rx, uint32_t now_ms) {
+  if (!rx->valid)
+    return 0;
+  if (!rx->running)
+    return rx->remaining_ms;
+
+  uint32_t elapsed = now_ms - rx->rx_ms;
+  return elapsed >= rx->remaining_ms ? 0 : rx->remaining_ms - elapsed;
+}
+
+void radio_clock_rx_feed(RadioClockRx *rx, const RadioFrame *frame,
+                         uint32_t now_ms) {
+  if (frame->type != RADIO_FRAME_CLOCK ||
+      frame->timer_channel != rx->timer_channel)
+    return;
+
+  bool running = frame->clock_flags & RADIO_FRAME_CLOCK_RUNNING;
+  if (rx->valid && rx->running && running && frame->epoch == rx->epoch) {
+    uint32_t local = radio_clock_rx_remaining_ms(rx, now_ms);
+    if (frame->remaining_ms > local &&
+        frame->remaining_ms - local < RADIO_CLOCK_RX_NO_BOUNCE_MS)
+      return;
+  }
+
+  rx->valid = true;
+  rx->running = running;
+  rx->null_signal = frame->clock_flags & RADIO_FRAME_CLOCK_NULL;
+  rx->mmss = frame->timer_channel != 0 &&
+             (frame->clock_flags & RADIO_FRAME_CLOCK_MMSS);
+  rx->epoch = frame->epoch;
+  rx->remaining_ms = frame->remaining_ms;
+  rx->rx_ms = now_ms;
+}
+
+uint32_t radio_frame_display_ms(uint32_t remaining_ms) {
+  if (remaining_ms >= 5000)
+    return (remaining_ms + 999) / 1000 * 1000;
+  return remaining_ms / 100 * 100;
+}
+
+// -----------------------------------------------------------------------------
+// Loss benchmark
+// -----------------------------------------------------------------------------
+#define LOSS_BENCH_STEP_MS 10
+#define LOSS_BENCH_START_MS 24000
+#define LOSS_BENCH_STOP_AT_MS 14200 // remaining when the official stops it
+#define LOSS_BENCH_STOPPED_MS 2000
+#define LOSS_BENCH_TAIL_MS 1000 // after zero
+
+static uint32_t loss_bench_rand(uint32_t *state) {
+  uint32_t x = *state; // xorshift32: same sequence on every platform
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *state = x;
+}
+
+// Legacy time value as the controller airs it, and back as a display
+// decodes it
+static uint16_t loss_bench_time_value(uint32_t remaining_ms) {
+  if (remaining_ms > 0 && remaining_ms < 5000)
+    return (uint16_t)(RADIO_TIME_DECISECONDS_BASE + remaining_ms / 100);
+  return (uint16_t)((remaining_ms + 999) / 1000);
+}
+
+// A deployed display takes bytes 0-1 of whatever it hears as the time
+static uint32_t loss_bench_legacy_ms(const uint8_t *payload) {
+  uint16_t value = (uint16_t)((payload[0] << 8) | payload[1]);
+  value &= ~RADIO_TIME_FLAG_WARN10;
+  if (value >= RADIO_TIME_DECISECONDS_BASE)
+    return (uint32_t)(value - RADIO_TIME_DECISECONDS_BASE) * 100;
+  return (uint32_t)value * 1000;
+}
+
+static void loss_bench_score(uint32_t truth, uint32_t shown, uint32_t *wrong,
+                             uint32_t *max_err, uint64_t *err_sum) {
+  uint32_t err = truth > shown ? truth - shown : shown - truth;
+  if (err == 0)
+    return;
+  *wrong += LOSS_BENCH_STEP_MS;
+  *err_sum += err;
+  if (err > *max_err)
+    *max_err = err;
+}
+
+void radio_frame_loss_benchmark(const RadioFrameLossCadence *cadence,
+                                uint8_t loss_pct, uint32_t seed,
+                                RadioFrameLossResult *out) {
+  memset(out, 0, sizeof(*out));
+  out->loss_pct = loss_pct;
+  uint32_t rng = seed ? seed : 1;
+
+  const uint32_t stop_at = LOSS_BENCH_START_MS - LOSS_BENCH_STOP_AT_MS;
+  const uint32_t restart_at = stop_at + LOSS_BENCH_STOPPED_MS;
+  const uint32_t end =
+      restart_at + LOSS_BENCH_STOP_AT_MS + LOSS_BENCH_TAIL_MS;
+
+  // All displays start in sync with the paused pre-game clock
+  uint32_t legacy_shown = LOSS_BENCH_START_MS;
+  uint32_t mixed_shown = LOSS_BENCH_START_MS;
+  RadioClockRx clock_rx;
+  radio_clock_rx_init(&clock_rx, 0);
+  RadioFrame frame = {.type = RADIO_FRAME_CLOCK,
+                      .remaining_ms = LOSS_BENCH_START_MS};
+  radio_clock_rx_feed(&clock_rx, &frame, 0);
+
+  uint8_t epoch = 0, sequence = 0;
+  bool was_running = false;
+  uint32_t last_display = LOSS_BENCH_START_MS, last_tick = 0, epoch_at = 0;
+
+  for (uint32_t t = 0; t < end; t += LOSS_BENCH_STEP_MS) {
+    // Controller clock
+    bool running = t < stop_at || t >= restart_at;
+    uint32_t rem;
+    if (t < stop_at)
+      rem = LOSS_BENCH_START_MS - t;
+    else if (t < restart_at)
+      rem = LOSS_BENCH_STOP_AT_MS;
+    else
+      rem = t - restart_at >= LOSS_BENCH_STOP_AT_MS
+                ? 0
+                : LOSS_BENCH_STOP_AT_MS - (t - restart_at);
+    if (rem == 0)
+      running = false;
+    uint32_t display = radio_frame_display_ms(rem);
+
+    // TX cadence: value change, start/stop (new epoch) or keep-alive
+    bool epoch_change = running != was_running;
+    if (epoch_change) {
+      epoch = (epoch + 1) & RADIO_FRAME_CLOCK_EPOCH_MASK;
+      epoch_at = t;
+    }
+    was_running = running;
+    uint32_t keepalive =
+        running || t - epoch_at < cadence->epoch_fast_ms
+            ? cadence->active_keepalive_ms
+            : cadence->idle_keepalive_ms;
+
+    if (epoch_change || display != last_display || t - last_tick >= keepalive) {
+      last_display = display;
+      last_tick = t;
+      out->ticks++;
+      sequence++;
+
+      if (loss_bench_rand(&rng) % 100 < loss_pct) {
+        out->ticks_lost++;
+      } else {
+        uint8_t payload[RADIO_FRAME_SIZE];
+        radio_frame_encode_time(payload, loss_bench_time_value(rem), 0, 0, 0,
+                                sequence);
+        legacy_shown = loss_bench_legacy_ms(payload);
+
+        radio_frame_encode_clock(payload, rem,
+                                 running ? RADIO_FRAME_CLOCK_RUNNING : 0,
+                                 epoch, sequence);
+        mixed_shown = loss_bench_legacy_ms(payload);
+        radio_frame_decode(payload, &frame);
+        radio_clock_rx_feed(&clock_rx, &frame, t);
+      }
+    }
+
+    loss_bench_score(display, legacy_shown, &out->legacy_wrong_ms,
+                     &out->legacy_max_err_ms, &out->legacy_err_sum_ms);
+    loss_bench_score(display, mixed_shown, &out->mixed_wrong_ms,
+                     &out->mixed_max_err_ms, &out->mixed_err_sum_ms);
+    loss_bench_score(display,
+                     radio_frame_display_ms(
+                         radio_clock_rx_remaining_ms(&clock_rx, t)),
+                     &out->clock_wrong_ms, &out->clock_max_err_ms,
+                     &out->clock_err_sum_ms);
+  }
+  out->sim_ms = end;
+}
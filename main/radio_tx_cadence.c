@@ -0,0 +1,119 @@
+#include "radio_tx_cadence.h"
+#include "../../radio-common/include/radio_config.h"
+
+bool radio_tx_policy_valid(const RadioTxPolicy *p) {
+  return p->active_keepalive_ms > 0 &&
+         p->active_keepalive_ms <= RADIO_RX_STALE_BOUND_MS &&
+         p->idle_keepalive_ms > 0 &&
+         p->idle_keepalive_ms <= RADIO_RX_STALE_BOUND_MS && p->copies >= 1 &&
+         p->copies <= RADIO_TX_BURST_MAX && p->final_copies >= 1 &&
+         p->final_copies <= RADIO_TX_BURST_MAX && p->extended_copies >= 1 &&
+         p->extended_copies <= RADIO_TX_BURST_MAX;
+}
+
+// -----------------------------------------------------------------------------
+// FRAME VALUE
+//  - Same rules the TFT uses: whole seconds (ceiling) normally, deciseconds
+//    (truncated, 256+d) inside the final 5s; rem_ms is rounded up so a
+//    deadline at an exact boundary already sees the new value
+// -----------------------------------------------------------------------------
+bool radio_tx_cadence_tenths(uint32_t rem_ms) {
+  return rem_ms > 0 && rem_ms < RADIO_TX_TENTHS_WINDOW_MS;
+}
+
+static uint16_t radio_tx_cadence_value(const RadioTxTick *t, uint32_t rem_ms) {
+  if (t->send_null)
+    return TIMER_NULL_SIGNAL;
+
+  uint16_t value = radio_tx_cadence_tenths(rem_ms)
+                       ? (uint16_t)(RADIO_TIME_DECISECONDS_BASE + rem_ms / 100)
+                       : (uint16_t)((rem_ms + 999) / 1000);
+  if (t->warn_at_10)
+    value |= RADIO_TIME_FLAG_WARN10;
+  return value;
+}
+
+// Largest remaining-ms value below rem_ms that carries a different value
+// (-1 = none: the clock is at zero)
+static int32_t radio_tx_cadence_next_boundary_ms(uint32_t rem_ms) {
+  if (rem_ms == 0)
+    return -1;
+
+  if (radio_tx_cadence_tenths(rem_ms)) {
+    uint32_t ds = rem_ms / 100;
+    return ds == 0 ? 0 : (int32_t)(ds * 100 - 1);
+  }
+
+  uint32_t sec = (rem_ms + 999) / 1000;
+  int32_t boundary = (int32_t)(sec - 1) * 1000;
+  // Dropping below the window switches to deciseconds at 4.999s, before
+  // the whole-second value would change
+  if (boundary < RADIO_TX_TENTHS_WINDOW_MS)
+    boundary = RADIO_TX_TENTHS_WINDOW_MS - 1;
+  return boundary;
+}
+
+// -----------------------------------------------------------------------------
+// TICK
+// -----------------------------------------------------------------------------
+void radio_tx_cadence_init(RadioTxCadence *c) {
+  c->last_tx_us = 0;
+  c->last_value = RADIO_TX_VALUE_NONE; // forces the first frame out
+  c->last_color = (color_t){0, 0, 0};
+  c->epoch_at_us = 0;
+}
+
+void radio_tx_cadence_force(RadioTxCadence *c) {
+  c->last_value = RADIO_TX_VALUE_NONE;
+}
+
+void radio_tx_cadence_plan(RadioTxCadence *c, const RadioTxPolicy *p,
+                           const RadioTxTick *t, RadioTxPlan *plan) {
+  uint32_t rem_ms = (t->rem_us + 999) / 1000;
+  if (t->new_epoch)
+    c->epoch_at_us = t->now_us;
+  plan->value = radio_tx_cadence_value(t, rem_ms);
+
+  // Idle = nothing is moving: paused, expired, or clearing displays. Only
+  // changes and the slow keep-alive go out then
+  bool idle = !t->running || rem_ms == 0 || t->send_null;
+  plan->keepalive_us =
+      (int64_t)(idle ? p->idle_keepalive_ms : p->active_keepalive_ms) * 1000;
+  if (t->switching ||
+      (p->extended_frames &&
+       t->now_us - c->epoch_at_us < (int64_t)RADIO_TX_EPOCH_FAST_MS * 1000))
+    plan->keepalive_us = (int64_t)p->active_keepalive_ms * 1000;
+
+  // Final seconds of a running clock (including the zero frame the horn
+  // keys off) get extra copies
+  bool final = t->running && !t->send_null && rem_ms <= p->final_window_ms;
+  plan->copies = final ? p->final_copies : p->copies;
+
+  bool changed = plan->value != c->last_value ||
+                 t->color.r != c->last_color.r ||
+                 t->color.g != c->last_color.g ||
+                 t->color.b != c->last_color.b ||
+                 (t->new_epoch && p->extended_frames);
+  plan->air = changed || t->now_us - c->last_tx_us >= plan->keepalive_us;
+}
+
+void radio_tx_cadence_sent(RadioTxCadence *c, const RadioTxTick *t,
+                           const RadioTxPlan *plan) {
+  c->last_tx_us = t->now_us;
+  c->last_value = plan->value;
+  c->last_color = t->color;
+}
+
+int64_t radio_tx_cadence_deadline(const RadioTxCadence *c,
+                                  const RadioTxTick *t,
+                                  const RadioTxPlan *plan) {
+  int64_t deadline = c->last_tx_us + plan->keepalive_us;
+  uint32_t rem_ms = (t->rem_us + 999) / 1000;
+  int32_t boundary = radio_tx_cadence_next_boundary_ms(rem_ms);
+  if (t->running && !t->send_null && boundary >= 0) {
+    int64_t at = t->now_us + t->rem_us - (int64_t)boundary * 1000;
+    if (at < deadline)
+      deadline = at;
+  }
+  return deadline;
+}
@@ -0,0 +1,631 @@
+#include "radio_tx_task.h"
+#include "../../radio-common/include/radio_config.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "main_events.h"
+#include "timer_manager.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char *TAG = "RADIO_TX";
+
+// -----------------------------------------------------------------------------
+// SNAPSHOT (seqlock)
+//  - Single writer (control loop), single reader (TX task); the writer never
+//    blocks inside the window, so a reader retry costs a few dozen cycles
+// -----------------------------------------------------------------------------
+void radio_tx_publish(RadioTx *tx, const RadioClockSnapshot *snap) {
+  uint32_t seq = tx->seq;
+  __atomic_store_n(&tx->seq, seq + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  tx->snap = *snap;
+  __atomic_store_n(&tx->seq, seq + 2, __ATOMIC_RELEASE);
+
+  xSemaphoreGive(tx->wake);
+}
+
+static void radio_tx_read(RadioTx *tx, RadioClockSnapshot *out) {
+  uint32_t before, after;
+  do {
+    before = __atomic_load_n(&tx->seq, __ATOMIC_ACQUIRE);
+    *out = tx->snap;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    after = __atomic_load_n(&tx->seq, __ATOMIC_RELAXED);
+  } while ((before & 1) || before != after);
+}
+
+// -----------------------------------------------------------------------------
+// EPOCHS
+// -----------------------------------------------------------------------------
+static uint32_t radio_tx_remaining_us(const RadioClockSnapshot *s,
+                                      int64_t now) {
+  uint32_t rem_us = s->remaining_us;
+  if (!s->running)
+    return rem_us;
+
+  int64_t elapsed = now - s->taken_us;
+  if (elapsed <= 0)
+    return rem_us;
+  return elapsed >= rem_us ? 0 : rem_us - (uint32_t)elapsed;
+}
+
+// A discontinuity starts a new epoch: the free-running displays must take
+// the next clock frame as a jump, not as drift to smooth over
+static bool radio_tx_epoch_check(RadioTx *tx, const RadioClockSnapshot *s,
+                                 uint32_t rem_us, int64_t now) {
+  bool jump = false;
+  if (tx->prev_now_us != 0) {
+    const RadioClockSnapshot *p = &tx->prev_snap;
+    if (s->running != p->running || s->send_null != p->send_null) {
+      jump = true;
+    } else {
+      int64_t expected = tx->prev_rem_us;
+      if (p->running) {
+        expected -= now - tx->prev_now_us;
+        if (expected < 0)
+          expected = 0;
+      }
+      int64_t diff = (int64_t)rem_us - expected;
+      jump = diff > RADIO_TX_EPOCH_JUMP_US || diff < -RADIO_TX_EPOCH_JUMP_US;
+    }
+  }
+
+  tx->prev_snap = *s;
+  tx->prev_rem_us = rem_us;
+  tx->prev_now_us = now;
+
+  if (jump)
+    tx->epoch = (tx->epoch + 1) & RADIO_FRAME_CLOCK_EPOCH_MASK;
+  return jump;
+}
+
+static int64_t radio_tx_court_remaining_us(const RadioClockSnapshot *s,
+                                           const RadioTimerSnapshot *t,
+                                           int64_t now) {
+  if (!t->running || now <= s->taken_us)
+    return t->remaining_us;
+  int64_t rem = t->remaining_us - (now - s->taken_us);
+  return rem > 0 ? rem : 0;
+}
+
+// Same discontinuity rule per court timer, each with its own epoch. Runs
+// before radio_tx_epoch_check(), which moves prev_snap/prev_now_us on
+static bool radio_tx_court_epoch_check(RadioTx *tx, const RadioClockSnapshot *s,
+                                       int64_t now) {
+  bool any = false;
+  for (uint8_t i = 0; i < s->court_count; i++) {
+    const RadioTimerSnapshot *t = &s->court[i];
+    int64_t rem = radio_tx_court_remaining_us(s, t, now);
+    bool jump = false;
+
+    if (tx->prev_now_us != 0) {
+      if (i >= tx->prev_snap.court_count ||
+          t->running != tx->prev_snap.court[i].running) {
+        jump = true;
+      } else {
+        int64_t expected = tx->court_prev_rem_us[i];
+        if (tx->prev_snap.court[i].running) {
+          expected -= now - tx->prev_now_us;
+          if (expected < 0)
+            expected = 0;
+        }
+        int64_t diff = rem - expected;
+        jump = diff > RADIO_TX_EPOCH_JUMP_US || diff < -RADIO_TX_EPOCH_JUMP_US;
+      }
+    }
+
+    tx->court_prev_rem_us[i] = rem;
+    if (jump) {
+      tx->court_epoch[i] =
+          (tx->court_epoch[i] + 1) & RADIO_FRAME_CLOCK_EPOCH_MASK;
+      tx->court_epoch_at_us[i] = now;
+      any = true;
+    }
+  }
+  return any;
+}
+
+// A stopped court timer with a settled epoch has nothing for its displays
+// to correct: it rides along only at the idle keep-alive, not every tick
+static void radio_tx_send_court(RadioTx *tx, const RadioClockSnapshot *s,
+                                int64_t now, uint8_t sequence) {
+  int64_t idle_us = (int64_t)tx->policy.idle_keepalive_ms * 1000;
+  for (uint8_t i = 0; i < s->court_count; i++) {
+    const RadioTimerSnapshot *t = &s->court[i];
+    if (!t->running &&
+        now - tx->court_epoch_at_us[i] >=
+            (int64_t)RADIO_TX_EPOCH_FAST_MS * 1000 &&
+        now - tx->court_last_tx_us[i] < idle_us)
+      continue;
+    tx->court_last_tx_us[i] = now;
+
+    uint32_t rem_ms =
+        (uint32_t)((radio_tx_court_remaining_us(s, t, now) + 999) / 1000);
+    uint8_t flags = 0;
+    if (t->running && rem_ms > 0)
+      flags |= RADIO_FRAME_CLOCK_RUNNING;
+    if (t->mmss)
+      flags |= RADIO_FRAME_CLOCK_MMSS;
+    radio_send_timer(tx->radio, t->channel, rem_ms, flags, tx->court_epoch[i],
+                     sequence);
+  }
+}
+
+static void radio_tx_send_clock(RadioTx *tx, const RadioClockSnapshot *s,
+                                uint32_t rem_ms, uint8_t sequence) {
+  uint8_t flags = 0;
+  if (s->running && rem_ms > 0)
+    flags |= RADIO_FRAME_CLOCK_RUNNING;
+  if (s->warn_at_10)
+    flags |= RADIO_FRAME_CLOCK_WARN10;
+  if (s->send_null)
+    flags |= RADIO_FRAME_CLOCK_NULL;
+  radio_send_clock(tx->radio, rem_ms, flags, tx->epoch, sequence);
+}
+
+// -----------------------------------------------------------------------------
+// TASK
+// -----------------------------------------------------------------------------
+static void radio_tx_deadline_cb(void *arg) {
+  RadioTx *tx = (RadioTx *)arg;
+  xSemaphoreGive(tx->wake);
+}
+
+// Receiver model: silence is measured between aired frames (a tick with at
+// least one copy out), checked on every wake-up
+static void radio_rx_model_check(RadioTx *tx, int64_t now) {
+  RadioRxModel *m = &tx->rx_model;
+  if (m->last_frame_us == 0)
+    return;
+
+  uint32_t silence = (uint32_t)(now - m->last_frame_us);
+  if (silence > m->max_silence_us)
+    m->max_silence_us = silence;
+}
+
+// Feed an aired frame to the follower (through the real encoding, so a
+// layout mistake shows up here rather than on the receivers)
+static void radio_rx_model_follow(RadioTx *tx, const uint8_t *payload,
+                                  int64_t now) {
+  RadioRxModel *m = &tx->rx_model;
+  RadioFrame frame;
+  radio_frame_decode(payload, &frame);
+  if (radio_frame_rx_feed(&m->follower, &frame, (uint32_t)(now / 1000)))
+    m->follower_hop_us = now;
+}
+
+static void radio_rx_model_frame(RadioTx *tx, int64_t now, uint16_t value,
+                                 color_t c, uint8_t sequence) {
+  RadioRxModel *m = &tx->rx_model;
+  if (m->last_frame_us != 0 &&
+      now - m->last_frame_us > (int64_t)RADIO_RX_STALE_BOUND_MS * 1000)
+    m->stale_events++;
+  radio_rx_model_check(tx, now);
+  m->last_frame_us = now;
+
+  // First frame on the new channel after a switch: did the follower get
+  // there, and how long was it without a frame
+  uint8_t channel = tx->radio->base.channel;
+  if (m->follower_hop_us != 0 && tx->switch_ticks_left == 0 &&
+      m->follower.channel == channel) {
+    ESP_LOGI(TAG, "Receiver model: re-acquired channel %u in %lu ms",
+             channel, (unsigned long)((now - m->follower_hop_us) / 1000));
+    m->follower_hop_us = 0;
+  } else if (m->follower.channel != channel && tx->switch_ticks_left == 0) {
+    ESP_LOGW(TAG, "Receiver model: left on channel %u (TX on %u)",
+             m->follower.channel, channel);
+    radio_frame_rx_init(&m->follower, channel);
+  }
+
+  uint8_t payload[RADIO_FRAME_SIZE];
+  radio_frame_encode_time(payload, value, c.r, c.g, c.b, sequence);
+  radio_rx_model_follow(tx, payload, now);
+}
+
+// -----------------------------------------------------------------------------
+// CHANNEL SWITCH
+//  - Each announcement tick airs the time frame, then the announcement with
+//    the same sequence; the tick carrying switch_sequence is the last one on
+//    the old channel. Receivers that follow hop after it, so the next frame
+//    (sent at once on the new channel) is the first they miss nothing of
+//  - Announcements are extended frames: without the policy opt-in the task
+//    hops at once, and receivers find the new channel by scanning
+// -----------------------------------------------------------------------------
+void radio_tx_request_channel(RadioTx *tx, uint8_t channel) {
+  __atomic_store_n(&tx->switch_request, (uint16_t)(0x100 | channel),
+                   __ATOMIC_RELEASE);
+  xSemaphoreGive(tx->wake);
+}
+
+static void radio_tx_take_switch_request(RadioTx *tx) {
+  uint16_t req = __atomic_exchange_n(&tx->switch_request, 0, __ATOMIC_ACQUIRE);
+  if (req == 0)
+    return;
+
+  uint8_t channel = req & 0xFF;
+  if (channel == tx->radio->base.channel) {
+    tx->switch_ticks_left = 0; // back to where we are: cancel
+    return;
+  }
+
+  channel_migrator_note_change(&tx->migrator,
+                               xTaskGetTickCount() * portTICK_PERIOD_MS);
+  tx->switch_target = channel;
+
+  if (!tx->policy.extended_frames) {
+    xSemaphoreTake(tx->lock, portMAX_DELAY);
+    radio_set_channel(tx->radio, channel);
+    xSemaphoreGive(tx->lock);
+    radio_frame_rx_init(&tx->rx_model.follower, channel);
+    tx->switch_ticks_left = 0;
+    radio_tx_cadence_force(&tx->cadence); // first frame on the new channel
+    ESP_LOGI(TAG, "Switched to channel %u (unannounced)", channel);
+    return;
+  }
+
+  tx->switch_ticks_left = RADIO_SWITCH_ANNOUNCE_TICKS;
+  tx->switch_sequence =
+      (uint8_t)(tx->sequence + RADIO_SWITCH_ANNOUNCE_TICKS - 1);
+  radio_tx_cadence_force(&tx->cadence); // first announcement tick now
+  ESP_LOGI(TAG, "Channel switch %u -> %u announced for %d ticks",
+           tx->radio->base.channel, channel, RADIO_SWITCH_ANNOUNCE_TICKS);
+}
+
+// Lock held. Returns true once the radio has hopped
+static bool radio_tx_announce(RadioTx *tx, uint8_t sequence, int64_t now) {
+  if (radio_send_switch(tx->radio, tx->switch_target, tx->switch_sequence,
+                        sequence)) {
+    uint8_t payload[RADIO_FRAME_SIZE];
+    radio_frame_encode_switch(payload, tx->switch_target, tx->switch_sequence,
+                              sequence);
+    radio_rx_model_follow(tx, payload, now);
+  }
+
+  if (--tx->switch_ticks_left > 0)
+    return false;
+
+  radio_set_channel(tx->radio, tx->switch_target);
+  ESP_LOGI(TAG, "Switched to channel %u after seq %u", tx->switch_target,
+           tx->switch_sequence);
+  return true;
+}
+
+static bool radio_tx_send(RadioTx *tx, uint16_t value, color_t c,
+                          uint8_t copies) {
+  RadioComm *radio = tx->radio;
+
+  radio_set_burst_copies(radio, copies);
+  bool ok = radio_send_time(radio, value, c.r, c.g, c.b, tx->sequence++);
+  if (ok) {
+    tx->consecutive_failures = 0;
+  } else if (++tx->consecutive_failures >= RADIO_CONSEC_FAIL_LIMIT) {
+    // Sustained failures suggest a wedged chip, not RF conditions:
+    // re-configure it (never restart - the timer must survive)
+    radio_recover(radio);
+    tx->consecutive_failures = 0;
+  }
+
+  // The status bar shows the link state: wake the control loop on a flip
+  bool was_good = radio->link_good;
+  radio_update_link_status(radio);
+  if (radio->link_good != was_good)
+    main_events_post(MAIN_EVT_LINK);
+  return ok;
+}
+
+// -----------------------------------------------------------------------------
+// BACKGROUND CHANNEL SAMPLING
+//  - One candidate per aired burst, in the gap before the next deadline; the
+//    survey leaves the chip in RX on the sampled channel, so the active
+//    channel and TX standby are restored before the lock is released
+// -----------------------------------------------------------------------------
+static const uint8_t radio_tx_candidates[] = RADIO_CHANNEL_CANDIDATES;
+
+static void radio_tx_profile_add(RadioChannelProfile *pr, uint8_t i,
+                                 uint16_t busy, uint16_t samples) {
+  uint32_t sample_q8 = ((uint32_t)busy * RADIO_SURVEY_SAMPLES * 256) / samples;
+  int32_t delta = (int32_t)sample_q8 - (int32_t)pr->score_q8[i];
+  pr->score_q8[i] =
+      (uint32_t)((int32_t)pr->score_q8[i] +
+                 delta / (1 << RADIO_BG_SURVEY_EWMA_SHIFT));
+  pr->busy_total[i] += busy;
+  pr->samples_total[i] += samples;
+}
+
+static void radio_tx_bg_sample(RadioTx *tx, int64_t deadline) {
+  if (deadline - esp_timer_get_time() < RADIO_BG_SURVEY_GUARD_US)
+    return;
+
+  RadioComm *radio = tx->radio;
+  RadioChannelProfile *pr = &tx->profile;
+
+  xSemaphoreTake(tx->lock, portMAX_DELAY);
+  uint8_t i = pr->next;
+  uint8_t active = radio->base.channel;
+  uint16_t busy = radio_common_survey_channel(
+      &radio->base, radio_tx_candidates[i], RADIO_BG_SURVEY_SAMPLES);
+  radio_set_channel(radio, active);
+  radio_tx_profile_add(pr, i, busy, RADIO_BG_SURVEY_SAMPLES);
+  pr->next = (uint8_t)((i + 1) % RADIO_CHANNEL_CANDIDATE_COUNT);
+  xSemaphoreGive(tx->lock);
+}
+
+void radio_tx_seed_channel_scores(RadioTx *tx, const uint16_t *scores) {
+  xSemaphoreTake(tx->lock, portMAX_DELAY);
+  for (uint8_t i = 0; i < RADIO_CHANNEL_CANDIDATE_COUNT; i++)
+    radio_tx_profile_add(&tx->profile, i, scores[i], RADIO_SURVEY_SAMPLES);
+  // A seed is a full snapshot: take it as-is rather than decayed from zero
+  for (uint8_t i = 0; i < RADIO_CHANNEL_CANDIDATE_COUNT; i++)
+    tx->profile.score_q8[i] = (uint32_t)scores[i] * 256;
+  xSemaphoreGive(tx->lock);
+}
+
+void radio_tx_get_channel_scores(RadioTx *tx, uint16_t *scores) {
+  xSemaphoreTake(tx->lock, portMAX_DELAY);
+  for (uint8_t i = 0; i < RADIO_CHANNEL_CANDIDATE_COUNT; i++)
+    scores[i] = (uint16_t)((tx->profile.score_q8[i] + 128) / 256);
+  xSemaphoreGive(tx->lock);
+}
+
+static uint8_t radio_tx_candidate_index(uint8_t channel) {
+  for (uint8_t i = 0; i < RADIO_CHANNEL_CANDIDATE_COUNT; i++) {
+    if (radio_tx_candidates[i] == channel)
+      return i;
+  }
+  return RADIO_CHANNEL_CANDIDATE_COUNT;
+}
+
+// Automatic migration: feed the migrator once per RADIO_MIGRATE_EVAL_MS and
+// request an (announced) switch when it decides to move
+static void radio_tx_migrate_check(RadioTx *tx) {
+  uint32_t now_ms = xTaskGetTickCount() * portTICK_PERIOD_MS;
+  if (!tx->policy.auto_migrate || tx->switch_ticks_left > 0 ||
+      now_ms - tx->last_migrate_eval_ms < RADIO_MIGRATE_EVAL_MS)
+    return;
+  tx->last_migrate_eval_ms = now_ms;
+
+  // A manually picked channel outside the list is left alone
+  uint8_t active = radio_tx_candidate_index(tx->radio->base.channel);
+  if (active >= RADIO_CHANNEL_CANDIDATE_COUNT)
+    return;
+
+  uint8_t busy_pct[RADIO_CHANNEL_CANDIDATE_COUNT];
+  RadioLinkStats stats;
+  xSemaphoreTake(tx->lock, portMAX_DELAY);
+  for (uint8_t i = 0; i < RADIO_CHANNEL_CANDIDATE_COUNT; i++)
+    busy_pct[i] = (uint8_t)(tx->profile.score_q8[i] * 100 /
+                            (RADIO_SURVEY_SAMPLES * 256));
+  radio_get_stats(tx->radio, &stats);
+  xSemaphoreGive(tx->lock);
+
+  ChannelMigratorInput in = {
+      .busy_pct = busy_pct,
+      .count = RADIO_CHANNEL_CANDIDATE_COUNT,
+      .active_idx = active,
+      .success_pct = stats.window_ticks > 0
+                         ? (int16_t)(stats.success_rate * 100.0f)
+                         : -1,
+  };
+  int target = channel_migrator_step(&tx->migrator, &in, now_ms);
+  if (target < 0)
+    return;
+
+  ESP_LOGW(TAG,
+           "Channel %u degraded (busy %u%%, TX success %d%%) - migrating to "
+           "%u (busy %u%%), migration #%u",
+           tx->radio->base.channel, busy_pct[active], in.success_pct,
+           radio_tx_candidates[target], busy_pct[target],
+           tx->migrator.migrations);
+  radio_tx_request_channel(tx, radio_tx_candidates[target]);
+}
+
+static void radio_tx_log_profile(RadioTx *tx) {
+  char line[128];
+  size_t len = 0;
+
+  xSemaphoreTake(tx->lock, portMAX_DELAY);
+  const RadioChannelProfile *pr = &tx->profile;
+  for (uint8_t i = 0; i < RADIO_CHANNEL_CANDIDATE_COUNT && len < sizeof(line);
+       i++) {
+    uint32_t now_pct = pr->score_q8[i] * 100 / (RADIO_SURVEY_SAMPLES * 256);
+    uint32_t long_pct = pr->samples_total[i]
+                            ? pr->busy_total[i] * 100 / pr->samples_total[i]
+                            : 0;
+    len += snprintf(line + len, sizeof(line) - len, " %u:%lu%%/%lu%%",
+                    radio_tx_candidates[i], (unsigned long)now_pct,
+                    (unsigned long)long_pct);
+  }
+  xSemaphoreGive(tx->lock);
+
+  ESP_LOGI(TAG, "Channel busy (now/long-term):%s", line);
+}
+
+static void radio_tx_log_jitter(RadioTx *tx) {
+  uint32_t now_ms = xTaskGetTickCount() * portTICK_PERIOD_MS;
+  if (now_ms - tx->last_log_ms < RADIO_LINK_LOG_INTERVAL_MS)
+    return;
+  tx->last_log_ms = now_ms;
+
+  RadioTxJitter *j = &tx->jitter;
+  if (j->samples > 0) {
+    ESP_LOGI(TAG, "TX deadline jitter: %lu frames, avg %lu us, max %lu us",
+             (unsigned long)j->samples, (unsigned long)(j->sum_us / j->samples),
+             (unsigned long)j->max_us);
+  }
+  memset(j, 0, sizeof(*j));
+
+  RadioRxModel *m = &tx->rx_model;
+  if (m->stale_events > 0) {
+    ESP_LOGW(TAG,
+             "Receiver model: %lu frames, longest silence %lu ms, %lu gaps "
+             "over the %u ms bound",
+             (unsigned long)tx->frames_aired,
+             (unsigned long)(m->max_silence_us / 1000),
+             (unsigned long)m->stale_events, RADIO_RX_STALE_BOUND_MS);
+  } else {
+    ESP_LOGI(TAG, "Receiver model: %lu frames, longest silence %lu ms",
+             (unsigned long)tx->frames_aired,
+             (unsigned long)(m->max_silence_us / 1000));
+  }
+  m->max_silence_us = 0;
+  m->stale_events = 0;
+  tx->frames_aired = 0;
+
+  radio_tx_log_profile(tx);
+}
+
+static void radio_tx_task(void *arg) {
+  RadioTx *tx = (RadioTx *)arg;
+
+  while (1) {
+    xSemaphoreTake(tx->wake, portMAX_DELAY);
+
+    int64_t now = esp_timer_get_time();
+    RadioClockSnapshot s;
+    radio_tx_read(tx, &s);
+    radio_tx_take_switch_request(tx);
+
+    uint32_t rem_us = radio_tx_remaining_us(&s, now);
+    uint32_t rem_ms = (rem_us + 999) / 1000;
+    bool court_epoch = radio_tx_court_epoch_check(tx, &s, now);
+    bool new_epoch = radio_tx_epoch_check(tx, &s, rem_us, now) || court_epoch;
+
+    // Color follows whole seconds in both modes (4.9s gets the <5s color)
+    uint32_t color_sec = radio_tx_cadence_tenths(rem_ms)
+                             ? rem_ms / 1000
+                             : (rem_ms + 999) / 1000;
+    RadioTxTick tick = {
+        .now_us = now,
+        .rem_us = rem_us,
+        .running = s.running,
+        .send_null = s.send_null,
+        .warn_at_10 = s.warn_at_10,
+        .color = color_lookup(s.color_scheme,
+                              color_sec > 0xFE ? 0xFE : (uint8_t)color_sec,
+                              s.brightness_idx)
+                     ->rgb,
+        .new_epoch = new_epoch,
+        .switching = tx->switch_ticks_left > 0,
+    };
+    const RadioTxPolicy *p = &tx->policy;
+    RadioTxPlan plan;
+    radio_tx_cadence_plan(&tx->cadence, p, &tick, &plan);
+
+    radio_rx_model_check(tx, now);
+
+    bool aired = false;
+    bool hopped = false;
+    if (plan.air) {
+      // Lateness against the deadline this wake-up was armed for (wake-ups
+      // from the control loop between deadlines are not measured)
+      if (tx->next_deadline_us != 0 && now >= tx->next_deadline_us) {
+        uint32_t late = (uint32_t)(now - tx->next_deadline_us);
+        tx->jitter.samples++;
+        tx->jitter.sum_us += late;
+        if (late > tx->jitter.max_us)
+          tx->jitter.max_us = late;
+      }
+
+      uint8_t sequence = tx->sequence;
+      xSemaphoreTake(tx->lock, portMAX_DELAY);
+      aired = radio_tx_send(tx, plan.value, tick.color, plan.copies);
+      if (aired) {
+        radio_rx_model_frame(tx, now, plan.value, tick.color, sequence);
+        tx->frames_aired++;
+      }
+      if (p->extended_frames) {
+        radio_set_burst_copies(tx->radio, p->extended_copies);
+        radio_tx_send_clock(tx, &s, rem_ms, sequence);
+        radio_tx_send_court(tx, &s, now, sequence);
+      }
+      if (tx->switch_ticks_left > 0)
+        hopped = radio_tx_announce(tx, sequence, now);
+      xSemaphoreGive(tx->lock);
+
+      radio_tx_cadence_sent(&tx->cadence, &tick, &plan);
+      if (hopped)
+        radio_tx_cadence_force(&tx->cadence); // new channel: air at once
+      radio_tx_log_jitter(tx);
+    }
+
+    int64_t deadline =
+        hopped ? now : radio_tx_cadence_deadline(&tx->cadence, &tick, &plan);
+
+    int64_t after = esp_timer_get_time();
+    esp_timer_stop(tx->timer);
+    esp_timer_start_once(tx->timer,
+                         deadline > after ? (uint64_t)(deadline - after) : 1);
+    tx->next_deadline_us = deadline;
+
+    if (aired && !hopped && tx->switch_ticks_left == 0) {
+      radio_tx_bg_sample(tx, deadline);
+      radio_tx_migrate_check(tx);
+    }
+  }
+}
+
+bool radio_tx_start(RadioTx *tx, RadioComm *radio,
+                    const RadioTxPolicy *policy) {
+  memset(tx, 0, sizeof(*tx));
+  tx->radio = radio;
+  tx->policy = RADIO_TX_POLICY_DEFAULT;
+  if (policy) {
+    if (radio_tx_policy_valid(policy))
+      tx->policy = *policy;
+    else
+      ESP_LOGE(TAG, "TX policy rejected (keep-alive above %u ms or bad copy "
+                    "count) - using defaults",
+               RADIO_RX_STALE_BOUND_MS);
+  }
+  radio_tx_cadence_init(&tx->cadence); // forces the first frame out
+  radio_frame_rx_init(&tx->rx_model.follower, radio->base.channel);
+  channel_migrator_init(&tx->migrator, NULL);
+  // The boot pick counts as a change: no migration in the first minute
+  channel_migrator_note_change(&tx->migrator,
+                               xTaskGetTickCount() * portTICK_PERIOD_MS);
+
+  tx->wake = xSemaphoreCreateBinary();
+  tx->lock = xSemaphoreCreateMutex();
+  if (!tx->wake || !tx->lock) {
+    ESP_LOGE(TAG, "Failed to create TX semaphores");
+    return false;
+  }
+
+  esp_timer_create_args_t timer_args = {
+      .callback = radio_tx_deadline_cb,
+      .arg = tx,
+      .dispatch_method = ESP_TIMER_TASK,
+      .name = "radio_tx",
+  };
+  if (esp_timer_create(&timer_args, &tx->timer) != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to create TX deadline timer");
+    return false;
+  }
+
+  if (xTaskCreatePinnedToCore(radio_tx_task, "radio_tx", RADIO_TX_TASK_STACK,
+                              tx, RADIO_TX_TASK_PRIORITY, &tx->task,
+                              RADIO_TX_TASK_CORE) != pdPASS) {
+    ESP_LOGE(TAG, "Failed to create TX task");
+    return false;
+  }
+
+  ESP_LOGI(TAG,
+           "Radio TX task started (core %d, priority %d) | keep-alive %lu ms "
+           "active, %lu ms idle | %u copies, %u in the final %lu ms | "
+           "auto-migrate %s | extended frames %s (%u copies)",
+           RADIO_TX_TASK_CORE, RADIO_TX_TASK_PRIORITY,
+           (unsigned long)tx->policy.active_keepalive_ms,
+           (unsigned long)tx->policy.idle_keepalive_ms, tx->policy.copies,
+           tx->policy.final_copies, (unsigned long)tx->policy.final_window_ms,
+           tx->policy.auto_migrate ? "on" : "off",
+           tx->policy.extended_frames ? "on" : "off",
+           tx->policy.extended_copies);
+  return true;
+}
+
+void radio_tx_lock(RadioTx *tx) { xSemaphoreTake(tx->lock, portMAX_DELAY); }
+
+void radio_tx_unlock(RadioTx *tx) { xSemaphoreGive(tx->lock); }
@@ -0,0 +1,99 @@
+#include "resume_state.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_rom_crc.h"
+#include "esp_rtc_time.h"
+#include "esp_system.h"
+#include <stddef.h>
+#include <string.h>
+
+static const char *TAG = "RESUME";
+
+typedef struct {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t size;
+  int64_t saved_rtc_us;
+  int64_t rtc_offset_us; // RTC time minus TimerClock time at the save
+  ResumeState state;
+  uint32_t crc; // over everything above
+} ResumeRecord;
+
+// Left alone by the bootloader and startup code on every reset but
+// power-on; garbage then, which the magic/size/CRC checks reject
+static RTC_NOINIT_ATTR ResumeRecord record;
+
+static uint32_t resume_state_crc(const ResumeRecord *r) {
+  return esp_rom_crc32_le(0, (const uint8_t *)r,
+                          offsetof(ResumeRecord, crc));
+}
+
+// Crashes that keep RTC memory and the RTC clock: the game was live a
+// moment ago. A software reset (esp_restart) is asked for and starts fresh
+static bool resume_state_reason_ok(esp_reset_reason_t reason) {
+  switch (reason) {
+  case ESP_RST_PANIC:
+  case ESP_RST_INT_WDT:
+  case ESP_RST_TASK_WDT:
+  case ESP_RST_WDT:
+  case ESP_RST_BROWNOUT:
+    return true;
+  default:
+    return false;
+  }
+}
+
+void resume_state_save(const TimerManager *timer_mgr, sport_type_t sport,
+                       uint8_t brightness_idx, uint8_t channel) {
+  int64_t rtc_now = (int64_t)esp_rtc_get_time_us();
+
+  record.magic = RESUME_STATE_MAGIC;
+  record.version = RESUME_STATE_VERSION;
+  record.size = sizeof(ResumeRecord);
+  record.saved_rtc_us = rtc_now;
+  record.rtc_offset_us = rtc_now - timer_clock_now_us(timer_mgr->clock);
+  record.state.sport = sport;
+  record.state.brightness_idx = brightness_idx;
+  record.state.channel = channel;
+  record.state.timer = *timer_mgr;
+  record.crc = resume_state_crc(&record);
+}
+
+void resume_state_clear(void) { memset(&record, 0, sizeof(record)); }
+
+bool resume_state_load(ResumeState *out, const TimerClock *clock) {
+  esp_reset_reason_t reason = esp_reset_reason();
+  int64_t rtc_now = (int64_t)esp_rtc_get_time_us();
+
+  bool valid = record.magic == RESUME_STATE_MAGIC &&
+               record.version == RESUME_STATE_VERSION &&
+               record.size == sizeof(ResumeRecord) &&
+               record.crc == resume_state_crc(&record) &&
+               record.state.timer.count >= 1 &&
+               record.state.timer.count <= TIMER_MAX_TIMERS;
+  if (!valid || !resume_state_reason_ok(reason) ||
+      rtc_now < record.saved_rtc_us) {
+    if (valid)
+      ESP_LOGI(TAG, "Snapshot not resumed (reset reason %d)", reason);
+    resume_state_clear();
+    return false;
+  }
+
+  *out = record.state;
+
+  // Move the timer instants from the old boot's clock to this one's via
+  // the RTC clock; the next update then runs the downtime off
+  TimerManager *t = &out->timer;
+  int64_t shift = record.rtc_offset_us - (rtc_now - timer_clock_now_us(clock));
+  t->clock = clock;
+  t->last_update_us += shift;
+  for (uint8_t i = 0; i < t->count; i++)
+    t->zero_reached_us[i] += shift;
+  timer_manager_update(t);
+
+  ESP_LOGW(TAG, "Resuming after reset (reason %d): %lld ms since the last "
+                "save, channel %u",
+           reason, (long long)((rtc_now - record.saved_rtc_us) / 1000),
+           out->channel);
+  return true;
+}
@@ -10,6 +10,7 @@ sport_config_t get_basketball_config(uint8_t seconds) {
     config.variation = (seconds == 24) ? "24 seconds" : "30 seconds";
     config.behavior = PLAYCLOCK_BEHAVIOR_MIXED;
     config.color_scheme = COLOR_SCHEME_BASKETBALL;
+    config.game_clock_seconds = 10 * 60; // FIBA quarter
     return config;
 }
 
@@ -56,7 +57,7 @@ sport_config_t get_baseball_config(uint8_t seconds) {
 sport_config_t get_sport_config(sport_type_t sport) {
     switch (sport) {
         case SPORT_PLAYCLOCK_NULL:
-            return (sport_config_t){SPORT_PLAYCLOCK_NULL, 255, "Play Clock", "Null/Empty", PLAYCLOCK_BEHAVIOR_RESET, COLOR_SCHEME_CUSTOM, false};
+            return (sport_config_t){SPORT_PLAYCLOCK_NULL, 255, "Play Clock", "Null/Empty", PLAYCLOCK_BEHAVIOR_RESET, COLOR_SCHEME_CUSTOM, false, 0};
         case SPORT_BASKETBALL_24_SEC:
             return get_basketball_config(24);
         case SPORT_BASKETBALL_30_SEC:
@@ -74,10 +75,10 @@ sport_config_t get_sport_config(sport_type_t sport) {
         case SPORT_BASEBALL_19_SEC:
             return get_baseball_config(19);
         case SPORT_VOLLEYBALL_8_SEC:
-            return (sport_config_t){SPORT_VOLLEYBALL_8_SEC, 8, "Volleyball", "8 seconds", PLAYCLOCK_BEHAVIOR_RESET, COLOR_SCHEME_VOLLEYBALL, false};
+            return (sport_config_t){SPORT_VOLLEYBALL_8_SEC, 8, "Volleyball", "8 seconds", PLAYCLOCK_BEHAVIOR_RESET, COLOR_SCHEME_VOLLEYBALL, false, 0};
         case SPORT_LACROSSE_30_SEC:
-            return (sport_config_t){SPORT_LACROSSE_30_SEC, 30, "Lacrosse", "30 seconds", PLAYCLOCK_BEHAVIOR_RESET, COLOR_SCHEME_LACROSSE, false};
+            return (sport_config_t){SPORT_LACROSSE_30_SEC, 30, "Lacrosse", "30 seconds", PLAYCLOCK_BEHAVIOR_RESET, COLOR_SCHEME_LACROSSE, false, 0};
         default:
-            return (sport_config_t){SPORT_PLAYCLOCK_NULL, 255, "Play Clock", "Null/Empty", PLAYCLOCK_BEHAVIOR_RESET, COLOR_SCHEME_CUSTOM, false};
+            return (sport_config_t){SPORT_PLAYCLOCK_NULL, 255, "Play Clock", "Null/Empty", PLAYCLOCK_BEHAVIOR_RESET, COLOR_SCHEME_CUSTOM, false, 0};
     }
 }
@@ -1,6 +1,8 @@
 #include "st7735_lcd.h"
 #include "driver/gpio.h"
 #include "driver/spi_master.h"
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
 #include "esp_log.h"
 #include <stdarg.h>
 #include <string.h>
@@ -8,54 +10,292 @@
 extern const uint8_t font8x8[96][8];
 static const char *TAG = "ST7735";
 
-// Larger DMA-able buffer for faster fills
-static uint16_t line_buf[256];
+// Ping-pong DMA line buffers; refs counts queued transactions still reading
+// each one (a solid fill queues the same buffer several times)
+static uint16_t line_buf[2][ST7735_LINE_BUF_PX];
+static uint8_t line_refs[2];
+
+// pre_cb runs in ISR context without the device: keep the DC pin here
+static gpio_num_t st_dc_pin;
+
+// Transaction user field: bit 0 = DC level, bits 1-2 = line buffer + 1
+#define ST_USER(dc, line) ((void *)(uintptr_t)((dc) | (((line) + 1) << 1)))
+#define ST_NO_LINE -1
 
 // ------------------------------------------------------
-// Low-level helpers
+// Transaction pipeline
 // ------------------------------------------------------
-static inline void st_cmd(St7735Lcd *lcd, uint8_t cmd) {
-  gpio_set_level(lcd->dc_pin, 0);
-  spi_transaction_t t = {
-      .length = 8,
-      .tx_buffer = &cmd,
-  };
-  spi_device_transmit(lcd->spi, &t);
+static void IRAM_ATTR st_pre_cb(spi_transaction_t *t) {
+  gpio_set_level(st_dc_pin, (uintptr_t)t->user & 1);
 }
 
-static inline void st_data(St7735Lcd *lcd, uint8_t data) {
-  gpio_set_level(lcd->dc_pin, 1);
-  spi_transaction_t t = {
-      .length = 8,
-      .tx_buffer = &data,
-  };
-  spi_device_transmit(lcd->spi, &t);
+static void st_release(St7735Lcd *lcd, spi_transaction_t *t) {
+  int line = (int)(((uintptr_t)t->user >> 1) & 3) - 1;
+  if (line >= 0)
+    line_refs[line]--;
+  lcd->trans_in_flight--;
+}
+
+static void st_reap_one(St7735Lcd *lcd) {
+  spi_transaction_t *done;
+  if (spi_device_get_trans_result(lcd->spi, &done, portMAX_DELAY) == ESP_OK)
+    st_release(lcd, done);
+}
+
+static spi_transaction_t *st_next_trans(St7735Lcd *lcd) {
+  if (lcd->trans_in_flight == ST7735_TRANS_RING)
+    st_reap_one(lcd);
+
+  spi_transaction_t *t = &lcd->trans[lcd->trans_head];
+  lcd->trans_head = (lcd->trans_head + 1) % ST7735_TRANS_RING;
+  memset(t, 0, sizeof(*t));
+  return t;
+}
+
+static void st_submit(St7735Lcd *lcd, spi_transaction_t *t) {
+  uint32_t bytes = t->length / 8;
+  if ((uintptr_t)t->user & 1)
+    lcd->stats.data_bytes += bytes;
+  else
+    lcd->stats.commands += bytes;
+  lcd->stats.transactions++;
+
+  spi_device_queue_trans(lcd->spi, t, portMAX_DELAY);
+  lcd->trans_in_flight++;
 }
 
+// Up to 4 bytes carried inside the descriptor (no buffer lifetime issues)
+static void st_queue_small(St7735Lcd *lcd, int dc, const uint8_t *bytes,
+                           int n) {
+  spi_transaction_t *t = st_next_trans(lcd);
+  t->flags = SPI_TRANS_USE_TXDATA;
+  t->length = n * 8;
+  t->user = ST_USER(dc, ST_NO_LINE);
+  memcpy(t->tx_data, bytes, n);
+  st_submit(lcd, t);
+}
+
+// Pixel payload; buf must stay untouched until the transaction is reaped
+static void st_queue_pixels(St7735Lcd *lcd, const uint16_t *buf, int count,
+                            int line) {
+  spi_transaction_t *t = st_next_trans(lcd);
+  t->length = count * 16;
+  t->tx_buffer = buf;
+  t->user = ST_USER(1, line);
+  if (line >= 0)
+    line_refs[line]++;
+  st_submit(lcd, t);
+}
+
+// Next ping-pong buffer, waiting for the DMA to let go of it
+static uint16_t *st_line_acquire(St7735Lcd *lcd, int *line) {
+  int idx = lcd->line_next;
+  lcd->line_next ^= 1;
+  while (line_refs[idx] > 0)
+    st_reap_one(lcd);
+  *line = idx;
+  return line_buf[idx];
+}
+
+// ------------------------------------------------------
+// Low-level helpers
+// ------------------------------------------------------
 static inline void st_data16(St7735Lcd *lcd, uint16_t data) {
   uint8_t buf[2] = {data >> 8, data & 0xFF};
-  gpio_set_level(lcd->dc_pin, 1);
-  spi_transaction_t t = {
-      .length = 16,
-      .tx_buffer = buf,
-  };
-  spi_device_transmit(lcd->spi, &t);
+  st_queue_small(lcd, 1, buf, 2);
+}
+
+// Prepare a solid-colour buffer for st_fill_pixels (enough for `pixels`)
+static uint16_t *st_fill_buf(St7735Lcd *lcd, uint16_t color, int pixels,
+                             int *line) {
+  uint16_t *buf = st_line_acquire(lcd, line);
+  int n = pixels < ST7735_LINE_BUF_PX ? pixels : ST7735_LINE_BUF_PX;
+  uint16_t c = __builtin_bswap16(color);
+  for (int i = 0; i < n; i++)
+    buf[i] = c;
+  return buf;
+}
+
+// Solid fill of the current window: one buffer, queued as often as needed
+static void st_fill_pixels(St7735Lcd *lcd, const uint16_t *buf, int line,
+                           int pixels) {
+  while (pixels > 0) {
+    int chunk = (pixels > ST7735_LINE_BUF_PX) ? ST7735_LINE_BUF_PX : pixels;
+    st_queue_pixels(lcd, buf, chunk, line);
+    pixels -= chunk;
+  }
+}
+
+// ------------------------------------------------------
+// Command lists: each op is one command transaction plus (optionally) one
+// parameter transaction of up to 4 bytes carried in the descriptor, all
+// queued back-to-back (DC is switched by pre_cb)
+// ------------------------------------------------------
+typedef struct {
+  uint8_t cmd;
+  uint8_t len; // parameter bytes, 0-4
+  uint8_t data[4];
+  uint8_t delay_ms; // wait after the op (drains the queue first)
+} St7735Op;
+
+#define ST7735_CMDLIST_MAX 8
+
+typedef struct {
+  St7735Op ops[ST7735_CMDLIST_MAX];
+  uint8_t count;
+} St7735CmdList;
+
+static void st_cmdlist_add(St7735CmdList *list, uint8_t cmd,
+                           const uint8_t *data, uint8_t len) {
+  St7735Op *op = &list->ops[list->count++];
+  op->cmd = cmd;
+  op->len = len;
+  op->delay_ms = 0;
+  if (len)
+    memcpy(op->data, data, len);
+}
+
+static void st_run_ops(St7735Lcd *lcd, const St7735Op *ops, int count) {
+  for (int i = 0; i < count; i++) {
+    st_queue_small(lcd, 0, &ops[i].cmd, 1);
+    if (ops[i].len)
+      st_queue_small(lcd, 1, ops[i].data, ops[i].len);
+    if (ops[i].delay_ms) {
+      st7735_wait_idle(lcd);
+      vTaskDelay(pdMS_TO_TICKS(ops[i].delay_ms));
+    }
+  }
 }
 
 // ------------------------------------------------------
-// Set draw window (with offsets applied)
+// Set draw window (with offsets applied): at most CASET+4, RASET+4, RAMWR
+// (5 transactions), and CASET/RASET are skipped when unchanged
 // ------------------------------------------------------
 static void st_set_addr(St7735Lcd *lcd, uint16_t x0, uint16_t y0, uint16_t x1,
                         uint16_t y1) {
-  st_cmd(lcd, ST7735_CASET);
-  st_data16(lcd, x0 + ST7735_XSTART);
-  st_data16(lcd, x1 + ST7735_XSTART);
+  lcd->stats.windows++;
+
+  St7735CmdList list = {.count = 0};
+
+  if (!lcd->win_valid || lcd->win.x0 != x0 || lcd->win.x1 != x1) {
+    uint8_t cols[4] = {(x0 + ST7735_XSTART) >> 8, (x0 + ST7735_XSTART) & 0xFF,
+                       (x1 + ST7735_XSTART) >> 8, (x1 + ST7735_XSTART) & 0xFF};
+    st_cmdlist_add(&list, ST7735_CASET, cols, 4);
+  }
+  if (!lcd->win_valid || lcd->win.y0 != y0 || lcd->win.y1 != y1) {
+    uint8_t rows[4] = {(y0 + ST7735_YSTART) >> 8, (y0 + ST7735_YSTART) & 0xFF,
+                       (y1 + ST7735_YSTART) >> 8, (y1 + ST7735_YSTART) & 0xFF};
+    st_cmdlist_add(&list, ST7735_RASET, rows, 4);
+  }
+  st_cmdlist_add(&list, ST7735_RAMWR, NULL, 0);
+
+  st_run_ops(lcd, list.ops, list.count);
+
+  lcd->win = (St7735Region){.x0 = x0, .y0 = y0, .x1 = x1, .y1 = y1};
+  lcd->win_valid = true;
+}
+
+// ------------------------------------------------------
+// Clip a rectangle to the panel; false if nothing is left
+// ------------------------------------------------------
+static bool st_clip(const St7735Lcd *lcd, int *x, int *y, int *w, int *h) {
+  if (*w <= 0 || *h <= 0)
+    return false;
+
+  if (*x < 0) {
+    *w += *x;
+    *x = 0;
+  }
+  if (*y < 0) {
+    *h += *y;
+    *y = 0;
+  }
+  if (*x + *w > lcd->width)
+    *w = lcd->width - *x;
+  if (*y + *h > lcd->height)
+    *h = lcd->height - *y;
+
+  return *w > 0 && *h > 0;
+}
+
+// ------------------------------------------------------
+// Dirty-region tracking (framebuffer mode)
+// ------------------------------------------------------
+static int st_region_area(const St7735Region *r) {
+  return (r->x1 - r->x0 + 1) * (r->y1 - r->y0 + 1);
+}
+
+static St7735Region st_region_union(const St7735Region *a,
+                                    const St7735Region *b) {
+  St7735Region u = {
+      .x0 = a->x0 < b->x0 ? a->x0 : b->x0,
+      .y0 = a->y0 < b->y0 ? a->y0 : b->y0,
+      .x1 = a->x1 > b->x1 ? a->x1 : b->x1,
+      .y1 = a->y1 > b->y1 ? a->y1 : b->y1,
+  };
+  return u;
+}
+
+// Pixels a merge would repaint that neither region needs
+static int st_region_merge_cost(const St7735Region *a, const St7735Region *b) {
+  St7735Region u = st_region_union(a, b);
+  return st_region_area(&u) - st_region_area(a) - st_region_area(b);
+}
+
+static void st_region_list_add(St7735Region *list, uint8_t *count,
+                               St7735Region r) {
+  // Fold into existing regions while cheap; a merged region can now reach
+  // others, so rescan until nothing folds
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    for (uint8_t i = 0; i < *count; i++) {
+      if (st_region_merge_cost(&r, &list[i]) <= ST7735_DIRTY_MERGE_SLACK) {
+        r = st_region_union(&r, &list[i]);
+        list[i] = list[--(*count)];
+        merged = true;
+        break;
+      }
+    }
+  }
 
-  st_cmd(lcd, ST7735_RASET);
-  st_data16(lcd, y0 + ST7735_YSTART);
-  st_data16(lcd, y1 + ST7735_YSTART);
+  if (*count < ST7735_DIRTY_MAX) {
+    list[(*count)++] = r;
+    return;
+  }
 
-  st_cmd(lcd, ST7735_RAMWR);
+  // List full: absorb into the region that grows least
+  uint8_t best = 0;
+  int best_cost = st_region_merge_cost(&r, &list[0]);
+  for (uint8_t i = 1; i < *count; i++) {
+    int cost = st_region_merge_cost(&r, &list[i]);
+    if (cost < best_cost) {
+      best_cost = cost;
+      best = i;
+    }
+  }
+  list[best] = st_region_union(&r, &list[best]);
+}
+
+// Urgent and normal regions never merge with each other, so a small urgent
+// update can't be inflated into a large one
+static void st_mark_dirty(St7735Lcd *lcd, int x0, int y0, int x1, int y1) {
+  St7735Region r = {.x0 = x0, .y0 = y0, .x1 = x1, .y1 = y1};
+  if (lcd->urgent)
+    st_region_list_add(lcd->urgent_dirty, &lcd->urgent_count, r);
+  else
+    st_region_list_add(lcd->dirty, &lcd->dirty_count, r);
+}
+
+static void st_fb_fill(St7735Lcd *lcd, int x, int y, int w, int h,
+                       uint16_t color) {
+  uint16_t c = __builtin_bswap16(color);
+  for (int row = y; row < y + h; row++) {
+    uint16_t *p = &lcd->fb[row * lcd->width + x];
+    for (int i = 0; i < w; i++)
+      p[i] = c;
+  }
+  st_mark_dirty(lcd, x, y, x + w - 1, y + h - 1);
 }
 
 // ------------------------------------------------------
@@ -72,6 +312,7 @@ bool st7735_begin(St7735Lcd *lcd, gpio_num_t cs, gpio_num_t dc, gpio_num_t rst,
   lcd->sck_pin = sclk;
   lcd->width = ST7735_WIDTH;
   lcd->height = ST7735_HEIGHT;
+  st_dc_pin = dc;
 
   ESP_LOGI(TAG, "Initializing ST7735 LCD");
 
@@ -92,7 +333,8 @@ bool st7735_begin(St7735Lcd *lcd, gpio_num_t cs, gpio_num_t dc, gpio_num_t rst,
       .sclk_io_num = sclk,
       .quadwp_io_num = -1,
       .quadhd_io_num = -1,
-      .max_transfer_sz = sizeof(line_buf) * 2, // pixels * 2 bytes
+      // Full-frame flush goes out as a single DMA transaction
+      .max_transfer_sz = ST7735_WIDTH * ST7735_HEIGHT * 2,
   };
 
   spi_bus_initialize(SPI2_HOST, &buscfg, SPI_DMA_CH_AUTO);
@@ -102,7 +344,8 @@ bool st7735_begin(St7735Lcd *lcd, gpio_num_t cs, gpio_num_t dc, gpio_num_t rst,
       .clock_speed_hz = 26 * 1000 * 1000,
       .mode = 0,
       .spics_io_num = cs,
-      .queue_size = 3,
+      .queue_size = ST7735_TRANS_RING,
+      .pre_cb = st_pre_cb,
   };
   spi_bus_add_device(SPI2_HOST, &devcfg, &lcd->spi);
 
@@ -115,58 +358,263 @@ bool st7735_begin(St7735Lcd *lcd, gpio_num_t cs, gpio_num_t dc, gpio_num_t rst,
   // ------------------------------------------------------
   // Full known-good init sequence
   // ------------------------------------------------------
-  st_cmd(lcd, ST7735_SWRESET);
-  vTaskDelay(pdMS_TO_TICKS(150));
+  static const St7735Op init_ops[] = {
+      {.cmd = ST7735_SWRESET, .delay_ms = 150},
+      {.cmd = ST7735_SLPOUT, .delay_ms = 150},
+      {.cmd = ST7735_COLMOD, .len = 1, .data = {0x05}}, // 16-bit color
+      // Orientation: 0x60 = 90 degree, 0x40 = flipped, 0x80 = 180 degree
+      {.cmd = ST7735_MADCTL, .len = 1, .data = {0xC0}},
+      {.cmd = ST7735_DISPON, .delay_ms = 100},
+  };
+  st_run_ops(lcd, init_ops, sizeof(init_ops) / sizeof(init_ops[0]));
 
-  st_cmd(lcd, ST7735_SLPOUT);
-  vTaskDelay(pdMS_TO_TICKS(150));
+  lcd->initialized = true;
+  ESP_LOGI(TAG, "ST7735 init OK");
+  return true;
+}
 
-  st_cmd(lcd, ST7735_COLMOD);
-  st_data(lcd, 0x05); // 16-bit color
+// ------------------------------------------------------
+// Pipeline state
+// ------------------------------------------------------
+bool st7735_busy(St7735Lcd *lcd) {
+  spi_transaction_t *done;
+  while (lcd->trans_in_flight > 0 &&
+         spi_device_get_trans_result(lcd->spi, &done, 0) == ESP_OK)
+    st_release(lcd, done);
+  return lcd->trans_in_flight > 0;
+}
 
-  st_cmd(lcd, ST7735_MADCTL);
-  // Orientation:
-  // st_data(lcd, 0x60); // 90 degree
-  // st_data(lcd, 0x40); // flipped
-  // st_data(lcd, 0x80); // 180 degree
-  st_data(lcd, 0xC0);
+void st7735_wait_idle(St7735Lcd *lcd) {
+  while (lcd->trans_in_flight > 0)
+    st_reap_one(lcd);
+}
 
-  st_cmd(lcd, ST7735_DISPON);
-  vTaskDelay(pdMS_TO_TICKS(100));
+void st7735_stats_reset(St7735Lcd *lcd) {
+  memset(&lcd->stats, 0, sizeof(lcd->stats));
+}
 
-  lcd->initialized = true;
-  ESP_LOGI(TAG, "ST7735 init OK");
-  return true;
+uint32_t st7735_framebuffer_checksum(const St7735Lcd *lcd) {
+  if (!lcd->fb)
+    return 0;
+
+  const uint8_t *p = (const uint8_t *)lcd->fb;
+  size_t n = (size_t)lcd->width * lcd->height * sizeof(uint16_t);
+  uint32_t h = 2166136261u;
+  for (size_t i = 0; i < n; i++) {
+    h ^= p[i];
+    h *= 16777619u;
+  }
+  return h;
 }
 
 // ------------------------------------------------------
-// Clear screen (fast fill)
+// Shadow framebuffer
 // ------------------------------------------------------
-void st7735_clear(St7735Lcd *lcd, uint16_t color) {
+bool st7735_framebuffer_enable(St7735Lcd *lcd) {
   if (!lcd->initialized)
+    return false;
+  if (lcd->fb)
+    return true;
+
+  size_t bytes = (size_t)lcd->width * lcd->height * sizeof(uint16_t);
+  lcd->fb = heap_caps_malloc(bytes, MALLOC_CAP_DMA);
+  if (!lcd->fb) {
+    ESP_LOGW(TAG, "No DMA memory for framebuffer - drawing direct");
+    return false;
+  }
+
+  // Panel contents are unknown: caller is expected to clear next
+  memset(lcd->fb, 0, bytes);
+  lcd->dirty_count = 0;
+  lcd->urgent_count = 0;
+  ESP_LOGI(TAG, "Shadow framebuffer enabled (%u bytes)", (unsigned)bytes);
+  return true;
+}
+
+static void st_flush_region(St7735Lcd *lcd, const St7735Region *r) {
+  int w = r->x1 - r->x0 + 1;
+  int h = r->y1 - r->y0 + 1;
+
+  st_set_addr(lcd, r->x0, r->y0, r->x1, r->y1);
+
+  if (w == lcd->width) {
+    // Full-width band is contiguous in the framebuffer: one DMA burst.
+    // A primitive touching it before the DMA finishes re-marks the area
+    // dirty, so at worst the next flush corrects a torn frame
+    st_queue_pixels(lcd, &lcd->fb[r->y0 * lcd->width], w * h, ST_NO_LINE);
     return;
+  }
 
-  uint16_t c = __builtin_bswap16(color);
-  for (int i = 0; i < 256; i++)
-    line_buf[i] = c;
+  // Narrow region: gather whole rows into the ping-pong buffers, filling
+  // one while the other is on the wire
+  int rows_per_chunk = ST7735_LINE_BUF_PX / w;
+  for (int y = r->y0; y <= r->y1; y += rows_per_chunk) {
+    int rows = r->y1 - y + 1;
+    if (rows > rows_per_chunk)
+      rows = rows_per_chunk;
+    int line;
+    uint16_t *buf = st_line_acquire(lcd, &line);
+    for (int k = 0; k < rows; k++)
+      memcpy(&buf[k * w], &lcd->fb[(y + k) * lcd->width + r->x0],
+             w * sizeof(uint16_t));
+    st_queue_pixels(lcd, buf, w * rows, line);
+  }
+}
 
-  st_set_addr(lcd, 0, 0, lcd->width - 1, lcd->height - 1);
+void st7735_flush(St7735Lcd *lcd) { st7735_flush_budget(lcd, UINT32_MAX); }
+
+uint32_t st7735_flush_budget(St7735Lcd *lcd, uint32_t max_bytes) {
+  if (!lcd->initialized || !lcd->fb)
+    return 0;
+
+  // Urgent regions (clock digits, status glyphs) are a few KB at most: they
+  // always go out whole and ahead of everything else
+  for (uint8_t i = 0; i < lcd->urgent_count; i++)
+    st_flush_region(lcd, &lcd->urgent_dirty[i]);
+  lcd->urgent_count = 0;
+
+  // Normal regions until the budget runs out; the last one is split on a
+  // row boundary and its remainder stays dirty for the next slice
+  uint32_t sent = 0;
+  while (lcd->dirty_count > 0) {
+    St7735Region *r = &lcd->dirty[lcd->dirty_count - 1];
+    uint32_t row_bytes = (uint32_t)(r->x1 - r->x0 + 1) * sizeof(uint16_t);
+    uint32_t h = r->y1 - r->y0 + 1;
+    uint32_t rows = (max_bytes - sent) / row_bytes;
+
+    if (rows >= h) {
+      st_flush_region(lcd, r);
+      sent += h * row_bytes;
+      lcd->dirty_count--;
+      continue;
+    }
 
-  int pixels = lcd->width * lcd->height;
+    // Always make progress, even with a budget below one row
+    if (rows == 0 && sent == 0)
+      rows = 1;
+    if (rows == 0)
+      break;
+
+    St7735Region part = *r;
+    part.y1 = r->y0 + rows - 1;
+    st_flush_region(lcd, &part);
+    r->y0 += rows;
+    break;
+  }
 
-  gpio_set_level(lcd->dc_pin, 1);
+  return st7735_pending_bytes(lcd);
+}
 
-  while (pixels > 0) {
-    int chunk = (pixels > 256) ? 256 : pixels;
-    spi_transaction_t t = {
-        .length = chunk * 16,
-        .tx_buffer = line_buf,
-    };
-    spi_device_transmit(lcd->spi, &t);
-    pixels -= chunk;
+uint32_t st7735_pending_bytes(const St7735Lcd *lcd) {
+  uint32_t bytes = 0;
+  for (uint8_t i = 0; i < lcd->dirty_count; i++)
+    bytes += st_region_area(&lcd->dirty[i]) * sizeof(uint16_t);
+  for (uint8_t i = 0; i < lcd->urgent_count; i++)
+    bytes += st_region_area(&lcd->urgent_dirty[i]) * sizeof(uint16_t);
+  return bytes;
+}
+
+void st7735_set_urgent(St7735Lcd *lcd, bool urgent) { lcd->urgent = urgent; }
+
+// ------------------------------------------------------
+// Glyph sprite cache
+// ------------------------------------------------------
+static void st_render_glyph(uint16_t *out, char c, uint16_t pix_fg,
+                            uint16_t pix_bg, uint8_t size) {
+  const uint8_t *glyph = font8x8[c - 32];
+  int w = 8 * size;
+  for (int py = 0; py < w; py++) {
+    uint8_t bits = glyph[py / size];
+    for (int px = 0; px < w; px++)
+      *out++ = (bits & (1 << (px / size))) ? pix_fg : pix_bg;
   }
 }
 
+bool st7735_sprite_cache_prepare(St7735Lcd *lcd, uint8_t size, uint16_t fg,
+                                 uint16_t bg) {
+  if (!lcd->initialized || size == 0)
+    return false;
+
+  St7735SpriteSet *set = NULL;
+  for (int i = 0; i < ST7735_SPRITE_SLOTS && !set; i++) {
+    if (lcd->sprites[i].pixels && lcd->sprites[i].size == size)
+      set = &lcd->sprites[i];
+  }
+  for (int i = 0; i < ST7735_SPRITE_SLOTS && !set; i++) {
+    if (!lcd->sprites[i].pixels)
+      set = &lcd->sprites[i];
+  }
+  if (!set) {
+    ESP_LOGW(TAG, "No free sprite slot for size %u", size);
+    return false;
+  }
+
+  if (set->valid && set->fg == fg && set->bg == bg)
+    return true;
+
+  int glyph_px = 64 * size * size;
+  if (!set->pixels) {
+    set->pixels = heap_caps_malloc(
+        ST7735_SPRITE_COUNT * glyph_px * sizeof(uint16_t), MALLOC_CAP_DMA);
+    if (!set->pixels) {
+      ESP_LOGW(TAG, "No DMA memory for size-%u sprites", size);
+      return false;
+    }
+  } else {
+    // Direct mode may still be streaming the old sprites
+    st7735_wait_idle(lcd);
+  }
+
+  uint16_t pix_fg = __builtin_bswap16(fg);
+  uint16_t pix_bg = __builtin_bswap16(bg);
+  for (size_t i = 0; i < ST7735_SPRITE_COUNT; i++)
+    st_render_glyph(&set->pixels[i * glyph_px], ST7735_SPRITE_CHARS[i], pix_fg,
+                    pix_bg, size);
+
+  set->size = size;
+  set->fg = fg;
+  set->bg = bg;
+  set->valid = true;
+  return true;
+}
+
+static const uint16_t *st_sprite_lookup(const St7735Lcd *lcd, char c,
+                                        uint16_t fg, uint16_t bg,
+                                        uint8_t size) {
+  const char *pos = strchr(ST7735_SPRITE_CHARS, c);
+  if (!pos || c == '\0')
+    return NULL;
+
+  for (int i = 0; i < ST7735_SPRITE_SLOTS; i++) {
+    const St7735SpriteSet *set = &lcd->sprites[i];
+    if (set->valid && set->size == size && set->fg == fg && set->bg == bg)
+      return &set->pixels[(pos - ST7735_SPRITE_CHARS) * 64 * size * size];
+  }
+  return NULL;
+}
+
+// ------------------------------------------------------
+// Clear screen (fast fill)
+// ------------------------------------------------------
+void st7735_clear(St7735Lcd *lcd, uint16_t color) {
+  if (!lcd->initialized)
+    return;
+
+  if (lcd->fb) {
+    // Whole screen repainted: any pending regions are subsumed
+    lcd->dirty_count = 0;
+    lcd->urgent_count = 0;
+    st_fb_fill(lcd, 0, 0, lcd->width, lcd->height, color);
+    return;
+  }
+
+  int pixels = lcd->width * lcd->height;
+  int line;
+  const uint16_t *buf = st_fill_buf(lcd, color, pixels, &line);
+  st_set_addr(lcd, 0, 0, lcd->width - 1, lcd->height - 1);
+  st_fill_pixels(lcd, buf, line, pixels);
+}
+
 // ------------------------------------------------------
 // Pixel
 // ------------------------------------------------------
@@ -176,6 +624,12 @@ void st7735_set_pixel(St7735Lcd *lcd, uint16_t x, uint16_t y, uint16_t color) {
   if (x >= lcd->width || y >= lcd->height)
     return;
 
+  if (lcd->fb) {
+    lcd->fb[y * lcd->width + x] = __builtin_bswap16(color);
+    st_mark_dirty(lcd, x, y, x, y);
+    return;
+  }
+
   st_set_addr(lcd, x, y, x, y);
   st_data16(lcd, color);
 }
@@ -188,44 +642,18 @@ void st7735_draw_rect(St7735Lcd *lcd, int x, int y, int w, int h,
   if (!lcd->initialized)
     return;
 
-  if (w <= 0 || h <= 0)
+  if (!st_clip(lcd, &x, &y, &w, &h))
     return;
 
-  if (x < 0) {
-    w += x;
-    x = 0;
-  }
-  if (y < 0) {
-    h += y;
-    y = 0;
-  }
-  if (x + w > lcd->width)
-    w = lcd->width - x;
-  if (y + h > lcd->height)
-    h = lcd->height - y;
-
-  if (w <= 0 || h <= 0)
+  if (lcd->fb) {
+    st_fb_fill(lcd, x, y, w, h, color);
     return;
+  }
 
+  int line;
+  const uint16_t *buf = st_fill_buf(lcd, color, w * h, &line);
   st_set_addr(lcd, x, y, x + w - 1, y + h - 1);
-
-  uint16_t c = __builtin_bswap16(color);
-  for (int i = 0; i < 256; i++)
-    line_buf[i] = c;
-
-  int pixels = w * h;
-
-  gpio_set_level(lcd->dc_pin, 1);
-
-  while (pixels > 0) {
-    int chunk = (pixels > 256) ? 256 : pixels;
-    spi_transaction_t t = {
-        .length = chunk * 16,
-        .tx_buffer = line_buf,
-    };
-    spi_device_transmit(lcd->spi, &t);
-    pixels -= chunk;
-  }
+  st_fill_pixels(lcd, buf, line, w * h);
 }
 
 // ------------------------------------------------------
@@ -239,17 +667,77 @@ void st7735_draw_rect_outline(St7735Lcd *lcd, int x, int y, int w, int h,
   if (w <= 0 || h <= 0)
     return;
 
-  // Top
-  st7735_draw_rect(lcd, x, y, w, 1, color);
+  St7735Rect r = {.x = x, .y = y, .w = w, .h = h};
+  st7735_draw_rect_outlines(lcd, &r, 1, color);
+}
 
-  // Bottom
-  st7735_draw_rect(lcd, x, y + h - 1, w, 1, color);
+// ------------------------------------------------------
+// Batched rectangles
+// ------------------------------------------------------
+void st7735_fill_rects(St7735Lcd *lcd, const St7735Rect *rects, int count,
+                       uint16_t color) {
+  if (!lcd->initialized || count <= 0)
+    return;
 
-  // Left
-  st7735_draw_rect(lcd, x, y, 1, h, color);
+  if (lcd->fb) {
+    for (int i = 0; i < count; i++) {
+      int x = rects[i].x, y = rects[i].y, w = rects[i].w, h = rects[i].h;
+      if (st_clip(lcd, &x, &y, &w, &h))
+        st_fb_fill(lcd, x, y, w, h, color);
+    }
+    return;
+  }
+
+  // One colour buffer sized for the largest rect, shared by every window
+  int max_px = 0;
+  for (int i = 0; i < count; i++) {
+    int px = rects[i].w * rects[i].h;
+    if (px > max_px)
+      max_px = px;
+  }
+  if (max_px <= 0)
+    return;
 
-  // Right
-  st7735_draw_rect(lcd, x + w - 1, y, 1, h, color);
+  int line;
+  const uint16_t *buf = st_fill_buf(lcd, color, max_px, &line);
+  for (int i = 0; i < count; i++) {
+    int x = rects[i].x, y = rects[i].y, w = rects[i].w, h = rects[i].h;
+    if (!st_clip(lcd, &x, &y, &w, &h))
+      continue;
+    st_set_addr(lcd, x, y, x + w - 1, y + h - 1);
+    st_fill_pixels(lcd, buf, line, w * h);
+  }
+}
+
+#define ST7735_OUTLINE_BATCH 8
+
+void st7735_draw_rect_outlines(St7735Lcd *lcd, const St7735Rect *rects,
+                               int count, uint16_t color) {
+  if (!lcd->initialized)
+    return;
+
+  // Edges of up to ST7735_OUTLINE_BATCH boxes per fill pass
+  St7735Rect edges[ST7735_OUTLINE_BATCH * 4];
+  int n = 0;
+
+  for (int i = 0; i < count; i++) {
+    const St7735Rect *r = &rects[i];
+    if (r->w <= 0 || r->h <= 0)
+      continue;
+
+    edges[n++] = (St7735Rect){r->x, r->y, r->w, 1};            // Top
+    edges[n++] = (St7735Rect){r->x, r->y + r->h - 1, r->w, 1}; // Bottom
+    edges[n++] = (St7735Rect){r->x, r->y, 1, r->h};            // Left
+    edges[n++] = (St7735Rect){r->x + r->w - 1, r->y, 1, r->h}; // Right
+
+    if (n == ST7735_OUTLINE_BATCH * 4) {
+      st7735_fill_rects(lcd, edges, n, color);
+      n = 0;
+    }
+  }
+
+  if (n > 0)
+    st7735_fill_rects(lcd, edges, n, color);
 }
 
 // ------------------------------------------------------
@@ -267,15 +755,56 @@ void st7735_draw_char(St7735Lcd *lcd, int x, int y, char c, uint16_t fg,
   int w = 8 * size;
   int h = 8 * size;
 
+  // Cached sprite, fully on screen: block copy instead of rasterizing
+  const uint16_t *sprite = st_sprite_lookup(lcd, c, fg, bg, size);
+  if (sprite && x >= 0 && y >= 0 && x + w <= lcd->width &&
+      y + h <= lcd->height) {
+    if (lcd->fb) {
+      for (int row = 0; row < h; row++)
+        memcpy(&lcd->fb[(y + row) * lcd->width + x], &sprite[row * w],
+               w * sizeof(uint16_t));
+      st_mark_dirty(lcd, x, y, x + w - 1, y + h - 1);
+    } else {
+      st_set_addr(lcd, x, y, x + w - 1, y + h - 1);
+      st_queue_pixels(lcd, sprite, w * h, ST_NO_LINE);
+    }
+    return;
+  }
+
+  if (lcd->fb) {
+    // Render into RAM, clipped per pixel (text may run off the panel edge)
+    uint16_t pix_fg = __builtin_bswap16(fg);
+    uint16_t pix_bg = __builtin_bswap16(bg);
+    for (int py = 0; py < h; py++) {
+      int sy = y + py;
+      if (sy < 0 || sy >= lcd->height)
+        continue;
+      uint8_t bits = glyph[py / size];
+      uint16_t *row = &lcd->fb[sy * lcd->width];
+      for (int px = 0; px < w; px++) {
+        int sx = x + px;
+        if (sx < 0 || sx >= lcd->width)
+          continue;
+        row[sx] = (bits & (1 << (px / size))) ? pix_fg : pix_bg;
+      }
+    }
+
+    int cx = x, cy = y, cw = w, ch = h;
+    if (st_clip(lcd, &cx, &cy, &cw, &ch))
+      st_mark_dirty(lcd, cx, cy, cx + cw - 1, cy + ch - 1);
+    return;
+  }
+
   // Set window once per character
   st_set_addr(lcd, x, y, x + w - 1, y + h - 1);
 
-  gpio_set_level(lcd->dc_pin, 1);
-
   uint16_t pix_fg = __builtin_bswap16(fg);
   uint16_t pix_bg = __builtin_bswap16(bg);
 
-  uint16_t buf[64];
+  // Rasterize into a ping-pong buffer (a size-4 glyph fits in one); the
+  // other buffer may still be on the wire with the previous character
+  int line;
+  uint16_t *buf = st_line_acquire(lcd, &line);
   int buf_i = 0;
 
   for (int row = 0; row < 8; row++) {
@@ -287,12 +816,9 @@ void st7735_draw_char(St7735Lcd *lcd, int x, int y, char c, uint16_t fg,
         for (int sx = 0; sx < size; sx++) {
           buf[buf_i++] = color;
 
-          if (buf_i == 64) {
-            spi_transaction_t t = {
-                .length = buf_i * 16,
-                .tx_buffer = buf,
-            };
-            spi_device_transmit(lcd->spi, &t);
+          if (buf_i == ST7735_LINE_BUF_PX) {
+            st_queue_pixels(lcd, buf, buf_i, line);
+            buf = st_line_acquire(lcd, &line);
             buf_i = 0;
           }
         }
@@ -300,13 +826,8 @@ void st7735_draw_char(St7735Lcd *lcd, int x, int y, char c, uint16_t fg,
     }
   }
 
-  if (buf_i > 0) {
-    spi_transaction_t t = {
-        .length = buf_i * 16,
-        .tx_buffer = buf,
-    };
-    spi_device_transmit(lcd->spi, &t);
-  }
+  if (buf_i > 0)
+    st_queue_pixels(lcd, buf, buf_i, line);
 }
 
 // ------------------------------------------------------
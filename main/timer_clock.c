@@ -0,0 +1,12 @@
+#include "timer_clock.h"
+#include "esp_timer.h"
+
+static int64_t timer_clock_esp_timer_read(void *ctx) {
+  (void)ctx;
+  return esp_timer_get_time();
+}
+
+const TimerClock *timer_clock_esp_timer(void) {
+  static const TimerClock clock = {.now_us = timer_clock_esp_timer_read};
+  return &clock;
+}
@@ -1,91 +1,363 @@
 #include "timer_manager.h"
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
+#include <stdio.h>
 
-static uint32_t now_ms(void) {
-  return xTaskGetTickCount() * portTICK_PERIOD_MS;
+#define US_PER_MS 1000
+#define US_PER_SECOND 1000000
+
+static int64_t now_us(const TimerManager *m) {
+  return timer_clock_now_us(m->clock);
 }
 
-void timer_manager_init(TimerManager *m, uint16_t initial_seconds) {
-  m->remaining_ms = (uint32_t)initial_seconds * 1000;
-  m->is_running = false;
-  m->last_update_ms = now_ms();
-  m->zero_reached_timestamp = 0;
+static int64_t timer_max_us(const TimerManager *m, uint8_t id) {
+  uint32_t max_s = m->format[id] == TIMER_FORMAT_MMSS ? TIMER_MAX_MMSS_SECONDS
+                                                      : TIMER_MAX_SECONDS;
+  return (int64_t)max_s * US_PER_SECOND;
 }
 
-void timer_manager_start(TimerManager *m) {
-  m->is_running = true;
-  m->last_update_ms = now_ms();
+static uint32_t timer_tenths_window_ms(const TimerManager *m, uint8_t id) {
+  return m->format[id] == TIMER_FORMAT_MMSS ? TIMER_MMSS_TENTHS_WINDOW_MS
+                                            : TIMER_TENTHS_WINDOW_MS;
 }
 
-void timer_manager_stop(TimerManager *m) {
+static bool timer_valid(const TimerManager *m, uint8_t id) {
+  return id < m->count;
+}
+
+// -----------------------------------------------------------------------------
+// LINK RULES
+//  - Followers are clamped after every change; a follower clamped to zero
+//    expires with its leader (same zero instant)
+// -----------------------------------------------------------------------------
+static void timer_manager_apply_caps(TimerManager *m) {
+  for (uint8_t i = 0; i < m->count; i++) {
+    uint8_t leader = m->link_leader[i];
+    if (leader == TIMER_NONE || !(m->link_rules[i] & TIMER_LINK_CAP))
+      continue;
+    if (m->remaining_us[i] <= m->remaining_us[leader])
+      continue;
+
+    m->remaining_us[i] = m->remaining_us[leader];
+    if (m->remaining_us[i] == 0 && !(m->state[i] & TIMER_STATE_ZERO)) {
+      m->state[i] |= TIMER_STATE_ZERO;
+      m->zero_reached_us[i] = (m->state[leader] & TIMER_STATE_ZERO)
+                                  ? m->zero_reached_us[leader]
+                                  : m->last_update_us;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// ONE-PASS UPDATE
+// -----------------------------------------------------------------------------
+void timer_manager_update(TimerManager *m) {
+  int64_t now = now_us(m);
+  int64_t elapsed = now - m->last_update_us;
+  if (elapsed <= 0)
+    return;
+
+  for (uint8_t i = 0; i < m->count; i++) {
+    if (!(m->state[i] & TIMER_STATE_RUNNING))
+      continue;
+
+    if (elapsed >= m->remaining_us[i]) {
+      // The zero instant itself, not this (later) update: the null-signal
+      // delay runs from the real expiry
+      if (!(m->state[i] & TIMER_STATE_ZERO)) {
+        m->state[i] |= TIMER_STATE_ZERO;
+        m->zero_reached_us[i] = m->last_update_us + m->remaining_us[i];
+      }
+      m->remaining_us[i] = 0;
+    } else {
+      m->remaining_us[i] -= elapsed;
+    }
+  }
+  m->last_update_us = now;
+  timer_manager_apply_caps(m);
+}
+
+// -----------------------------------------------------------------------------
+// SETUP
+// -----------------------------------------------------------------------------
+static void timer_manager_init_slot(TimerManager *m, uint8_t id,
+                                    TimerFormat format, uint16_t seconds,
+                                    uint8_t radio_channel) {
+  m->format[id] = (uint8_t)format;
+  m->state[id] = 0;
+  m->zero_reached_us[id] = 0;
+  m->link_leader[id] = TIMER_NONE;
+  m->link_rules[id] = 0;
+  m->radio_channel[id] = radio_channel;
+  m->remaining_us[id] = (int64_t)seconds * US_PER_SECOND;
+  if (m->remaining_us[id] > timer_max_us(m, id))
+    m->remaining_us[id] = timer_max_us(m, id);
+}
+
+void timer_manager_init(TimerManager *m, uint16_t initial_seconds,
+                        const TimerClock *clock) {
+  m->clock = clock;
+  m->count = 1;
+  m->last_update_us = now_us(m);
+  timer_manager_init_slot(m, TIMER_PLAY, TIMER_FORMAT_SECONDS, 0, 0);
+  // The play clock keeps its historical range (the null sport's 255)
+  m->remaining_us[TIMER_PLAY] = (int64_t)initial_seconds * US_PER_SECOND;
+}
+
+uint8_t timer_manager_add(TimerManager *m, TimerFormat format,
+                          uint16_t seconds, uint8_t radio_channel) {
+  if (m->count >= TIMER_MAX_TIMERS)
+    return TIMER_NONE;
+
+  timer_manager_update(m);
+  uint8_t id = m->count++;
+  timer_manager_init_slot(m, id, format, seconds, radio_channel);
+  return id;
+}
+
+void timer_manager_drop_court_timers(TimerManager *m) {
+  timer_manager_update(m);
+  m->count = 1;
+  m->link_leader[TIMER_PLAY] = TIMER_NONE;
+  m->link_rules[TIMER_PLAY] = 0;
+}
+
+bool timer_manager_link(TimerManager *m, uint8_t follower, uint8_t leader,
+                        uint8_t rules) {
+  if (!timer_valid(m, follower) || !timer_valid(m, leader) ||
+      follower == leader)
+    return false;
+
+  timer_manager_update(m);
+  m->link_leader[follower] = leader;
+  m->link_rules[follower] = rules;
+  if ((rules & TIMER_LINK_STOP) && !(m->state[leader] & TIMER_STATE_RUNNING))
+    m->state[follower] &= ~TIMER_STATE_RUNNING;
+  timer_manager_apply_caps(m);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// PER-TIMER CONTROL
+//  - Every change first brings all timers to the same instant, so starting
+//    one never hands another the time it spent stopped
+// -----------------------------------------------------------------------------
+void timer_manager_timer_start(TimerManager *m, uint8_t id) {
+  if (!timer_valid(m, id))
+    return;
+
+  timer_manager_update(m);
+  uint8_t leader = m->link_leader[id];
+  if (leader != TIMER_NONE && (m->link_rules[id] & TIMER_LINK_STOP) &&
+      !(m->state[leader] & TIMER_STATE_RUNNING))
+    return;
+
+  m->state[id] |= TIMER_STATE_RUNNING;
+  // Starting an already-expired clock still stamps its zero
+  if (m->remaining_us[id] == 0 && !(m->state[id] & TIMER_STATE_ZERO)) {
+    m->state[id] |= TIMER_STATE_ZERO;
+    m->zero_reached_us[id] = m->last_update_us;
+  }
+
+  for (uint8_t i = 0; i < m->count; i++) {
+    if (m->link_leader[i] == id && (m->link_rules[i] & TIMER_LINK_START) &&
+        m->remaining_us[i] > 0)
+      m->state[i] |= TIMER_STATE_RUNNING;
+  }
+}
+
+void timer_manager_timer_stop(TimerManager *m, uint8_t id) {
+  if (!timer_valid(m, id))
+    return;
+
   // Accrue the partial second before freezing so stop preserves the
   // exact remaining time (stop at 3.4 resumes at 3.4)
   timer_manager_update(m);
-  m->is_running = false;
+  m->state[id] &= ~TIMER_STATE_RUNNING;
+
+  for (uint8_t i = 0; i < m->count; i++) {
+    if (m->link_leader[i] == id && (m->link_rules[i] & TIMER_LINK_STOP))
+      m->state[i] &= ~TIMER_STATE_RUNNING;
+  }
 }
 
-void timer_manager_start_stop(TimerManager *m) {
-  if (m->is_running)
-    timer_manager_stop(m);
-  else
-    timer_manager_start(m);
+void timer_manager_timer_reset(TimerManager *m, uint8_t id,
+                               uint16_t seconds) {
+  if (!timer_valid(m, id))
+    return;
+
+  timer_manager_update(m);
+  m->remaining_us[id] = (int64_t)seconds * US_PER_SECOND;
+  if (id != TIMER_PLAY && m->remaining_us[id] > timer_max_us(m, id))
+    m->remaining_us[id] = timer_max_us(m, id);
+  m->state[id] &= ~TIMER_STATE_ZERO;
+  timer_manager_apply_caps(m);
 }
 
-void timer_manager_reset(TimerManager *m, uint16_t seconds) {
-  m->remaining_ms = (uint32_t)seconds * 1000;
-  m->zero_reached_timestamp = 0;
-  m->last_update_ms = now_ms();
+bool timer_manager_timer_is_running(const TimerManager *m, uint8_t id) {
+  return timer_valid(m, id) && (m->state[id] & TIMER_STATE_RUNNING);
 }
 
-void timer_manager_update(TimerManager *m) {
-  if (!m->is_running)
-    return;
+int64_t timer_manager_timer_remaining_us(const TimerManager *m, uint8_t id) {
+  return timer_valid(m, id) ? m->remaining_us[id] : 0;
+}
+
+TimerFormat timer_manager_timer_format(const TimerManager *m, uint8_t id) {
+  return (TimerFormat)m->format[id];
+}
 
-  uint32_t now = now_ms();
-  uint32_t elapsed = now - m->last_update_ms;
-  m->last_update_ms = now;
+uint8_t timer_manager_timer_radio_channel(const TimerManager *m, uint8_t id) {
+  return m->radio_channel[id];
+}
 
-  m->remaining_ms = (elapsed >= m->remaining_ms) ? 0 : m->remaining_ms - elapsed;
+void timer_manager_timer_text(const TimerManager *m, uint8_t id, char *buf,
+                              size_t len) {
+  int64_t rem_us = timer_manager_timer_remaining_us(m, id);
+  uint32_t rem_ms = (uint32_t)((rem_us + US_PER_MS - 1) / US_PER_MS);
 
-  if (m->remaining_ms == 0 && m->zero_reached_timestamp == 0) {
-    m->zero_reached_timestamp = now;
+  // Same rounding as the play clock: tenths truncated, seconds ceiling
+  if (rem_ms > 0 && rem_ms < timer_tenths_window_ms(m, id)) {
+    uint32_t ds = (uint32_t)(rem_us / (US_PER_SECOND / 10));
+    snprintf(buf, len, "%lu.%lu", (unsigned long)(ds / 10),
+             (unsigned long)(ds % 10));
+    return;
   }
+
+  uint32_t sec = (rem_ms + 999) / 1000;
+  if (m->format[id] == TIMER_FORMAT_MMSS)
+    snprintf(buf, len, "%lu:%02lu", (unsigned long)(sec / 60),
+             (unsigned long)(sec % 60));
+  else
+    snprintf(buf, len, "%lu", (unsigned long)sec);
+}
+
+// -----------------------------------------------------------------------------
+// PLAY CLOCK (single-timer API)
+// -----------------------------------------------------------------------------
+void timer_manager_start(TimerManager *m) {
+  timer_manager_timer_start(m, TIMER_PLAY);
+}
+
+void timer_manager_stop(TimerManager *m) {
+  timer_manager_timer_stop(m, TIMER_PLAY);
+}
+
+void timer_manager_start_stop(TimerManager *m) {
+  if (timer_manager_is_running(m))
+    timer_manager_stop(m);
+  else
+    timer_manager_start(m);
+}
+
+void timer_manager_reset(TimerManager *m, uint16_t seconds) {
+  timer_manager_timer_reset(m, TIMER_PLAY, seconds);
 }
 
 bool timer_manager_should_send_null(const TimerManager *m) {
-  if (m->remaining_ms != 0 || m->zero_reached_timestamp == 0)
+  if (m->remaining_us[TIMER_PLAY] != 0 ||
+      !(m->state[TIMER_PLAY] & TIMER_STATE_ZERO))
     return false;
 
-  return (now_ms() - m->zero_reached_timestamp) >= TIMER_NULL_SIGNAL_DELAY_MS;
+  return now_us(m) - m->zero_reached_us[TIMER_PLAY] >=
+         (int64_t)TIMER_NULL_SIGNAL_DELAY_MS * US_PER_MS;
 }
 
 uint16_t timer_manager_get_seconds(const TimerManager *m) {
-  return (uint16_t)((m->remaining_ms + 999) / 1000);
+  return (uint16_t)((m->remaining_us[TIMER_PLAY] + US_PER_SECOND - 1) /
+                    US_PER_SECOND);
 }
 
 uint16_t timer_manager_get_deciseconds(const TimerManager *m) {
-  return (uint16_t)(m->remaining_ms / 100);
+  return (uint16_t)(m->remaining_us[TIMER_PLAY] / (US_PER_SECOND / 10));
 }
 
 uint32_t timer_manager_get_remaining_ms(const TimerManager *m) {
-  return m->remaining_ms;
+  return (uint32_t)((m->remaining_us[TIMER_PLAY] + US_PER_MS - 1) /
+                    US_PER_MS);
+}
+
+int64_t timer_manager_get_remaining_us(const TimerManager *m) {
+  return m->remaining_us[TIMER_PLAY];
+}
+
+int64_t timer_manager_get_sample_us(const TimerManager *m) {
+  return m->last_update_us;
 }
 
 void timer_manager_adjust_ms(TimerManager *m, int32_t delta_ms) {
-  if (m->is_running)
+  if (timer_manager_is_running(m))
     return;
 
-  int64_t adjusted = (int64_t)m->remaining_ms + delta_ms;
+  timer_manager_update(m);
+  int64_t adjusted =
+      m->remaining_us[TIMER_PLAY] + (int64_t)delta_ms * US_PER_MS;
   if (adjusted < 0)
     adjusted = 0;
-  if (adjusted > (int64_t)TIMER_MAX_SECONDS * 1000)
-    adjusted = (int64_t)TIMER_MAX_SECONDS * 1000;
+  if (adjusted > timer_max_us(m, TIMER_PLAY))
+    adjusted = timer_max_us(m, TIMER_PLAY);
+
+  m->remaining_us[TIMER_PLAY] = adjusted;
+  if (adjusted > 0)
+    m->state[TIMER_PLAY] &= ~TIMER_STATE_ZERO;
+  timer_manager_apply_caps(m);
+}
 
-  m->remaining_ms = (uint32_t)adjusted;
-  if (m->remaining_ms > 0) {
-    m->zero_reached_timestamp = 0;
+bool timer_manager_is_running(const TimerManager *m) {
+  return timer_manager_timer_is_running(m, TIMER_PLAY);
+}
+
+// -----------------------------------------------------------------------------
+// NEXT EVENT
+// -----------------------------------------------------------------------------
+
+// Largest remaining-ms value below rem_ms that displays differently (-1 =
+// none: the clock is at zero). Mirrors the ceiling-seconds/truncated-tenths
+// rules of get_seconds()/get_deciseconds()
+static int64_t timer_manager_next_boundary_ms(uint32_t rem_ms,
+                                              uint32_t window_ms) {
+  if (rem_ms == 0)
+    return -1;
+
+  if (rem_ms < window_ms) {
+    uint32_t ds = rem_ms / 100;
+    return ds == 0 ? 0 : (int64_t)ds * 100 - 1;
   }
+
+  int64_t boundary = (int64_t)((rem_ms + 999) / 1000 - 1) * 1000;
+  // Entering the window switches to tenths at 4.999s (59.999s for mm:ss),
+  // before the whole second would change
+  if (boundary < window_ms)
+    boundary = window_ms - 1;
+  return boundary;
 }
 
-bool timer_manager_is_running(const TimerManager *m) { return m->is_running; }
+int64_t timer_manager_next_event_us(const TimerManager *m) {
+  int64_t now = now_us(m);
+  int64_t next = -1;
+
+  // Only the play clock clears the displays with the null signal
+  if (m->remaining_us[TIMER_PLAY] == 0 &&
+      (m->state[TIMER_PLAY] & TIMER_STATE_ZERO)) {
+    int64_t at = m->zero_reached_us[TIMER_PLAY] +
+                 (int64_t)TIMER_NULL_SIGNAL_DELAY_MS * US_PER_MS;
+    if (at > now)
+      next = at - now;
+  }
+
+  for (uint8_t i = 0; i < m->count; i++) {
+    if (!(m->state[i] & TIMER_STATE_RUNNING) || m->remaining_us[i] == 0)
+      continue;
+
+    int64_t rem_us = m->remaining_us[i] - (now - m->last_update_us);
+    if (rem_us <= 0)
+      return 0;
+
+    uint32_t rem_ms = (uint32_t)((rem_us + US_PER_MS - 1) / US_PER_MS);
+    int64_t boundary_ms =
+        timer_manager_next_boundary_ms(rem_ms, timer_tenths_window_ms(m, i));
+    int64_t until = rem_us - boundary_ms * US_PER_MS;
+    if (until < 0)
+      until = 0;
+    if (next < 0 || until < next)
+      next = until;
+  }
+  return next;
+}
@@ -1,5 +1,6 @@
 #include "ui_helpers.h"
 #include "ui_manager.h"
+#include <stdio.h>
 #include <string.h>
 
 void ui_format_seconds(char *out, size_t size, uint16_t sec) {
@@ -9,6 +10,11 @@ void ui_format_seconds(char *out, size_t size, uint16_t sec) {
     snprintf(out, size, "%d", sec);
 }
 
+static int ui_center_x(const St7735Lcd *lcd, int len, uint8_t size) {
+  int x = (lcd->width - len * 8 * size) / 2;
+  return x < 0 ? 0 : x;
+}
+
 void ui_st7735_print_center(St7735Lcd *lcd, int y, uint16_t fg, uint16_t bg,
                             uint8_t size, const char *text) {
   if (!lcd || !lcd->initialized || !text)
@@ -18,12 +24,68 @@ void ui_st7735_print_center(St7735Lcd *lcd, int y, uint16_t fg, uint16_t bg,
   if (len <= 0)
     return;
 
-  int text_width = len * 8 * size;
-  int x = (lcd->width - text_width) / 2;
-  if (x < 0)
-    x = 0;
+  st7735_print(lcd, ui_center_x(lcd, len, size), y, fg, bg, size, text);
+}
+
+void ui_st7735_print_center_diff(St7735Lcd *lcd, UiTextCache *cache, int y,
+                                 uint16_t fg, uint16_t bg, uint8_t size,
+                                 const char *text) {
+  if (!lcd || !lcd->initialized || !text)
+    return;
+
+  int len = strlen(text);
+  if (len >= (int)sizeof(cache->text))
+    len = sizeof(cache->text) - 1;
+
+  int cw = 8 * size;
+  int x = ui_center_x(lcd, len, size);
+
+  // Different row/scale/colours: nothing on screen can be reused
+  if (cache->valid && (cache->y != y || cache->size != size ||
+                       cache->fg != fg || cache->bg != bg)) {
+    st7735_draw_rect(lcd, cache->x, cache->y,
+                     strlen(cache->text) * 8 * cache->size, 8 * cache->size,
+                     cache->bg);
+    cache->valid = false;
+  }
+
+  int old_len = cache->valid ? (int)strlen(cache->text) : 0;
+
+  for (int i = 0; i < len; i++) {
+    int px = x + i * cw;
 
-  st7735_print(lcd, x, y, fg, bg, size, text);
+    // Same character already in this exact cell ("10" -> "09" keeps '0'
+    // only if it didn't move; a width change shifts the centering)
+    if (old_len > 0 && (px - cache->x) % cw == 0) {
+      int j = (px - cache->x) / cw;
+      if (j >= 0 && j < old_len && cache->text[j] == text[i])
+        continue;
+    }
+    st7735_draw_char(lcd, px, y, text[i], fg, bg, size);
+  }
+
+  // Clear the strips of the old text outside the new extent
+  if (old_len > 0) {
+    int old_end = cache->x + old_len * cw;
+    int new_end = x + len * cw;
+    if (cache->x < x) {
+      int right = old_end < x ? old_end : x;
+      st7735_draw_rect(lcd, cache->x, y, right - cache->x, cw, bg);
+    }
+    if (old_end > new_end) {
+      int left = cache->x > new_end ? cache->x : new_end;
+      st7735_draw_rect(lcd, left, y, old_end - left, cw, bg);
+    }
+  }
+
+  memcpy(cache->text, text, len);
+  cache->text[len] = '\0';
+  cache->x = x;
+  cache->y = y;
+  cache->fg = fg;
+  cache->bg = bg;
+  cache->size = size;
+  cache->valid = true;
 }
 
 void ui_draw_st7735_header_underline(St7735Lcd *lcd) {
@@ -43,4 +105,12 @@ void ui_draw_st7735_header_underline(St7735Lcd *lcd) {
 void ui_draw_st7735_frame(UiManager *m) {
   st7735_draw_rect_outline(&m->st7735, 0, 0, ST7735_WIDTH, ST7735_HEIGHT,
                            ST7735_BLUE);
+}
+
+void ui_draw_st7735_blank_screen(UiManager *m) {
+  st7735_clear(&m->st7735, ST7735_BLACK);
+  ui_draw_st7735_frame(m);
+  m->clock.valid = false;
+  m->game_clock.valid = false;
+  m->menu.screen = UI_SCREEN_NONE;
 }
\ No newline at end of file
@@ -24,4 +24,13 @@ void ui_format_seconds(char *out, size_t size, uint16_t sec);
 void ui_st7735_print_center(St7735Lcd *lcd, int y, uint16_t fg, uint16_t bg,
                             uint8_t size, const char *text);
 void ui_draw_st7735_header_underline(St7735Lcd *lcd);
-void ui_draw_st7735_frame(UiManager *m);
\ No newline at end of file
+void ui_draw_st7735_frame(UiManager *m);
+
+// Clear + frame for a full-screen draw; forgets retained on-screen state
+void ui_draw_st7735_blank_screen(UiManager *m);
+
+// Centered text that repaints only changed cells against *cache, and clears
+// whatever part of the previous text the new one no longer covers
+void ui_st7735_print_center_diff(St7735Lcd *lcd, UiTextCache *cache, int y,
+                                 uint16_t fg, uint16_t bg, uint8_t size,
+                                 const char *text);
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "ui_st7735_variant_bar.h"
 #include "ui_manager.h"
 #include <stdio.h>
+#include <string.h>
 
 void ui_draw_st7735_main(UiManager *m, const sport_config_t *sport,
                          uint16_t sec, const SportManager *sm) {
@@ -11,8 +12,7 @@ void ui_draw_st7735_main(UiManager *m, const sport_config_t *sport,
   char timebuf[8];
   ui_format_seconds(timebuf, sizeof(timebuf), sec);
 
-  st7735_clear(lcd, ST7735_BLACK);
-  ui_draw_st7735_frame(m);
+  ui_draw_st7735_blank_screen(m);
 
   // Header
   ui_st7735_print_center(lcd, UI_ST7735_HEADER_Y, ST7735_WHITE, ST7735_BLACK, 1,
@@ -24,8 +24,11 @@ void ui_draw_st7735_main(UiManager *m, const sport_config_t *sport,
   // Variant bar
   ui_draw_st7735_variant_bar(m, sm);
 
-  // Big timer
-  ui_st7735_print_center(lcd, 85, ST7735_WHITE, ST7735_BLACK, 4, timebuf);
+  // Big timer (seeds the differential cache for the per-second updates)
+  ui_st7735_print_center_diff(lcd, &m->clock, 85, ST7735_WHITE, ST7735_BLACK,
+                              4, timebuf);
+
+  m->menu.screen = UI_SCREEN_MAIN;
 }
 
 void ui_st7735_draw_status(UiManager *m, bool running, bool link_good,
@@ -65,12 +68,10 @@ void ui_st7735_update_time(UiManager *m, const sport_config_t *sport,
   char buf[8];
   ui_format_seconds(buf, sizeof(buf), sec);
 
-  St7735Lcd *lcd = &m->st7735;
-
-  // Only clear big timer area (no flicker)
-  st7735_draw_rect(lcd, 10, 70, ST7735_WIDTH - 20, 80, ST7735_BLACK);
-
-  ui_st7735_print_center(lcd, 85, ST7735_WHITE, ST7735_BLACK, 4, buf);
+  // Only the digit cells that changed are repainted (usually one), so
+  // there is no clear-then-print flicker
+  ui_st7735_print_center_diff(&m->st7735, &m->clock, 85, ST7735_WHITE,
+                              ST7735_BLACK, 4, buf);
 }
 
 void ui_st7735_update_time_tenths(UiManager *m, const sport_config_t *sport,
@@ -79,14 +80,32 @@ void ui_st7735_update_time_tenths(UiManager *m, const sport_config_t *sport,
   (void)sport;
   (void)sm;
 
-  // "4.9" style; called at ~10Hz in the final 5s - same partial-area
-  // redraw as the whole-second path
+  // "4.9" style; called at ~10Hz in the final 5s - same differential
+  // redraw as the whole-second path ("05" -> "4.9" re-centres and clears
+  // the uncovered edges; "4.9" -> "4.8" repaints one cell)
   char buf[8];
   snprintf(buf, sizeof(buf), "%u.%u", deciseconds / 10, deciseconds % 10);
 
-  St7735Lcd *lcd = &m->st7735;
+  ui_st7735_print_center_diff(&m->st7735, &m->clock, 85, ST7735_WHITE,
+                              ST7735_BLACK, 4, buf);
+}
 
-  st7735_draw_rect(lcd, 10, 70, ST7735_WIDTH - 20, 80, ST7735_BLACK);
+void ui_st7735_update_game_clock(UiManager *m, const char *text) {
+  St7735Lcd *lcd = &m->st7735;
+  UiTextCache *cache = &m->game_clock;
+
+  if (text[0] == '\0') {
+    if (cache->valid) {
+      st7735_draw_rect(lcd, cache->x, cache->y,
+                       strlen(cache->text) * 8 * cache->size, 8 * cache->size,
+                       cache->bg);
+      cache->valid = false;
+    }
+    return;
+  }
 
-  ui_st7735_print_center(lcd, 85, ST7735_WHITE, ST7735_BLACK, 4, buf);
-}
\ No newline at end of file
+  // Below the big clock (85 + 4 x 8 px), in the game clock's own colour so
+  // it is never mistaken for the play clock
+  ui_st7735_print_center_diff(lcd, cache, 130, ST7735_CYAN, ST7735_BLACK, 2,
+                              text);
+}
@@ -14,5 +14,6 @@ void ui_st7735_update_time(UiManager *m, const sport_config_t *sport,
 void ui_st7735_update_time_tenths(UiManager *m, const sport_config_t *sport,
                                   uint16_t deciseconds,
                                   const SportManager *sm);
+void ui_st7735_update_game_clock(UiManager *m, const char *text);
 void ui_st7735_draw_status(UiManager *m, bool running, bool link_good,
                            uint8_t brightness_pct);
\ No newline at end of file
@@ -6,40 +6,140 @@
 #include <stdio.h>
 #include <string.h>
 
+// -----------------------------------------------------------------------------
+// Row painters: each row is fixed-width text over a black background, so
+// repainting one row fully replaces what was there
+// -----------------------------------------------------------------------------
+static void ui_draw_sport_row(St7735Lcd *lcd, const sport_group_t *groups,
+                              uint8_t i, bool selected) {
+  sport_config_t cfg = get_sport_config(groups[i].variants[0]);
+
+  char line[32];
+  snprintf(line, sizeof(line), "%c %s", selected ? '>' : ' ', cfg.name);
+
+  st7735_print(lcd, UI_ST7735_MARGIN + 4,
+               UI_ST7735_MENU_LIST_Y + i * UI_ST7735_LINE_SPACING, ST7735_WHITE,
+               ST7735_BLACK, 1, line);
+}
+
+static void ui_draw_variant_row(St7735Lcd *lcd, const sport_group_t *group,
+                                uint8_t i, bool selected) {
+  sport_config_t cfg = get_sport_config(group->variants[i]);
+  char line[32];
+  snprintf(line, sizeof(line), "%c%u %u", selected ? '>' : ' ', i + 1,
+           cfg.play_clock_seconds);
+
+  uint16_t fg = selected ? UI_ST7735_VARIANT_HIGHLIGHT_COLOR : ST7735_WHITE;
+  ui_st7735_print_center(lcd,
+                         UI_ST7735_VARIANT_LIST_Y +
+                             i * UI_ST7735_VARIANT_SPACING,
+                         fg, ST7735_BLACK, 2, line);
+}
+
+// Occupancy bar: survey busy-count scaled to 0-8 '#' chars
+static uint8_t ui_channel_bar_len(uint16_t score) {
+  uint8_t bar_len = (uint8_t)((score * 8) / RADIO_SURVEY_SAMPLES);
+  return bar_len > 8 ? 8 : bar_len;
+}
+
+static void ui_draw_channel_row(St7735Lcd *lcd, uint8_t channel,
+                                uint8_t bar_len, uint8_t i, bool selected,
+                                bool active) {
+  char bar[9];
+  for (uint8_t b = 0; b < 8; b++)
+    bar[b] = (b < bar_len) ? '#' : ' ';
+  bar[8] = '\0';
+
+  char line[32];
+  snprintf(line, sizeof(line), "%c%3u %s%c", selected ? '>' : ' ', channel,
+           bar, active ? '*' : ' ');
+
+  uint16_t color = selected ? UI_ST7735_VARIANT_HIGHLIGHT_COLOR
+                            : UI_ST7735_VARIANT_NORMAL_COLOR;
+  st7735_print(lcd, UI_ST7735_MARGIN + 4,
+               UI_ST7735_MENU_LIST_Y + i * UI_ST7735_LINE_SPACING, color,
+               ST7735_BLACK, 1, line);
+}
+
+// -----------------------------------------------------------------------------
+// Sport menu
+// -----------------------------------------------------------------------------
 void ui_draw_st7735_sport_menu(UiManager *m, const sport_group_t *groups,
                                size_t group_count, uint8_t selected_idx) {
+  if (m->menu.screen == UI_SCREEN_SPORT_MENU &&
+      m->menu.count == group_count) {
+    ui_st7735_update_sport_menu_selection(m, groups, group_count,
+                                          selected_idx);
+    return;
+  }
+
   St7735Lcd *lcd = &m->st7735;
 
-  st7735_clear(lcd, ST7735_BLACK);
-  ui_draw_st7735_frame(m);
+  ui_draw_st7735_blank_screen(m);
 
   ui_st7735_print_center(lcd, UI_ST7735_HEADER_Y, ST7735_YELLOW, ST7735_BLACK, 1,
                           "SELECT SPORT");
 
   ui_draw_st7735_header_underline(lcd);
 
-  int y = UI_ST7735_MENU_LIST_Y;
+  for (size_t i = 0; i < group_count; i++)
+    ui_draw_sport_row(lcd, groups, i, i == selected_idx);
 
-  for (size_t i = 0; i < group_count; i++) {
-    sport_config_t cfg = get_sport_config(groups[i].variants[0]);
+  m->menu.screen = UI_SCREEN_SPORT_MENU;
+  m->menu.count = group_count;
+  m->menu.selected_idx = selected_idx;
+}
 
-    char line[32];
-    snprintf(line, sizeof(line), "%c %s", (i == selected_idx) ? '>' : ' ',
-             cfg.name);
+void ui_st7735_update_sport_menu_selection(UiManager *m,
+                                           const sport_group_t *groups,
+                                           size_t group_count,
+                                           uint8_t selected_group_idx) {
+  // Menu not (or no longer) on screen, e.g. a coalesced redraw: paint it
+  if (m->menu.screen != UI_SCREEN_SPORT_MENU ||
+      m->menu.count != group_count) {
+    ui_draw_st7735_sport_menu(m, groups, group_count, selected_group_idx);
+    return;
+  }
 
-    st7735_print(lcd, UI_ST7735_MARGIN + 4, y, ST7735_WHITE, ST7735_BLACK, 1,
-                 line);
+  uint8_t old_idx = m->menu.selected_idx;
+  if (old_idx == selected_group_idx)
+    return;
 
-    y += UI_ST7735_LINE_SPACING;
-  }
+  // Only the '>' cell of the old and new rows changes
+  St7735Lcd *lcd = &m->st7735;
+  if (old_idx < group_count)
+    st7735_print(lcd, UI_ST7735_MARGIN + 4,
+                 UI_ST7735_MENU_LIST_Y + old_idx * UI_ST7735_LINE_SPACING,
+                 ST7735_WHITE, ST7735_BLACK, 1, " ");
+  st7735_print(lcd, UI_ST7735_MARGIN + 4,
+               UI_ST7735_MENU_LIST_Y +
+                   selected_group_idx * UI_ST7735_LINE_SPACING,
+               ST7735_WHITE, ST7735_BLACK, 1, ">");
+
+  m->menu.selected_idx = selected_group_idx;
 }
 
+// -----------------------------------------------------------------------------
+// Variant menu
+// -----------------------------------------------------------------------------
 void ui_draw_st7735_variant_menu(UiManager *m, const sport_group_t *group,
                                  uint8_t selected_idx) {
   St7735Lcd *lcd = &m->st7735;
 
-  st7735_clear(lcd, ST7735_BLACK);
-  ui_draw_st7735_frame(m);
+  // Same group on screen: repaint the old and new selection rows only
+  if (group && m->menu.screen == UI_SCREEN_VARIANT_MENU &&
+      m->menu.group == group) {
+    uint8_t old_idx = m->menu.selected_idx;
+    if (old_idx != selected_idx) {
+      if (old_idx < group->variant_count)
+        ui_draw_variant_row(lcd, group, old_idx, false);
+      ui_draw_variant_row(lcd, group, selected_idx, true);
+      m->menu.selected_idx = selected_idx;
+    }
+    return;
+  }
+
+  ui_draw_st7735_blank_screen(m);
 
   if (!group || group->variant_count == 0) {
     ui_st7735_print_center(lcd, UI_ST7735_HEADER_Y, ST7735_WHITE, ST7735_BLACK, 1,
@@ -55,78 +155,65 @@ void ui_draw_st7735_variant_menu(UiManager *m, const sport_group_t *group,
 
   ui_draw_st7735_header_underline(lcd);
 
-  int y = UI_ST7735_VARIANT_LIST_Y;
-
-  for (uint8_t i = 0; i < group->variant_count; i++) {
-    sport_config_t cfg = get_sport_config(group->variants[i]);
-    char line[32];
-    snprintf(line, sizeof(line), "%c%u %u", (i == selected_idx) ? '>' : ' ',
-             i + 1, cfg.play_clock_seconds);
+  for (uint8_t i = 0; i < group->variant_count; i++)
+    ui_draw_variant_row(lcd, group, i, i == selected_idx);
 
-    uint16_t fg = (i == selected_idx) ? UI_ST7735_VARIANT_HIGHLIGHT_COLOR
-                                      : ST7735_WHITE;
-    ui_st7735_print_center(lcd, y, fg, ST7735_BLACK, 2, line);
-
-    y += UI_ST7735_VARIANT_SPACING;
-  }
+  m->menu.screen = UI_SCREEN_VARIANT_MENU;
+  m->menu.group = group;
+  m->menu.count = group->variant_count;
+  m->menu.selected_idx = selected_idx;
 }
 
-void ui_st7735_update_sport_menu_selection(UiManager *m,
-                                           const sport_group_t *groups,
-                                           size_t group_count,
-                                           uint8_t selected_group_idx) {
-  St7735Lcd *lcd = &m->st7735;
-  int y = UI_ST7735_MENU_LIST_Y;
-
-  for (size_t i = 0; i < group_count; i++) {
-    char marker = (i == selected_group_idx) ? '>' : ' ';
-
-    st7735_draw_rect(lcd, UI_ST7735_MARGIN + 2, y, 10, 10, ST7735_BLACK);
-
-    char str[2] = {marker, '\0'};
-    st7735_print(lcd, UI_ST7735_MARGIN + 2, y, ST7735_WHITE, ST7735_BLACK, 1,
-                 str);
-
-    y += UI_ST7735_LINE_SPACING;
-  }
-}
+// -----------------------------------------------------------------------------
+// Channel menu
+// -----------------------------------------------------------------------------
 void ui_draw_st7735_channel_menu(UiManager *m, const uint8_t *channels,
                                  const uint16_t *scores, uint8_t count,
                                  uint8_t selected_idx, uint8_t active_idx) {
   St7735Lcd *lcd = &m->st7735;
 
-  st7735_clear(lcd, ST7735_BLACK);
-  ui_draw_st7735_frame(m);
+  if (count > UI_CMD_MAX_CHANNELS)
+    count = UI_CMD_MAX_CHANNELS;
+
+  // Same menu on screen: repaint rows whose selection, '*' or bar changed
+  if (m->menu.screen == UI_SCREEN_CHANNEL_MENU && m->menu.count == count) {
+    for (uint8_t i = 0; i < count; i++) {
+      uint8_t bar_len = ui_channel_bar_len(scores[i]);
+      bool was_selected = (i == m->menu.selected_idx);
+      bool was_active = (i == m->menu.active_idx);
+      bool selected = (i == selected_idx);
+      bool active = (i == active_idx);
+
+      if (bar_len != m->menu.bar_len[i] || was_selected != selected ||
+          was_active != active) {
+        ui_draw_channel_row(lcd, channels[i], bar_len, i, selected, active);
+        m->menu.bar_len[i] = bar_len;
+      }
+    }
+    m->menu.selected_idx = selected_idx;
+    m->menu.active_idx = active_idx;
+    return;
+  }
+
+  ui_draw_st7735_blank_screen(m);
 
   ui_st7735_print_center(lcd, UI_ST7735_HEADER_Y, ST7735_YELLOW, ST7735_BLACK,
                          1, "RADIO CHANNEL");
 
   ui_draw_st7735_header_underline(lcd);
 
-  int y = UI_ST7735_MENU_LIST_Y;
-
   for (uint8_t i = 0; i < count; i++) {
-    // Occupancy bar: survey busy-count scaled to 0-8 '#' chars
-    char bar[9];
-    uint8_t bar_len = (uint8_t)((scores[i] * 8) / RADIO_SURVEY_SAMPLES);
-    if (bar_len > 8)
-      bar_len = 8;
-    for (uint8_t b = 0; b < 8; b++)
-      bar[b] = (b < bar_len) ? '#' : ' ';
-    bar[8] = '\0';
-
-    char line[32];
-    snprintf(line, sizeof(line), "%c%3u %s%c",
-             (i == selected_idx) ? '>' : ' ', channels[i], bar,
-             (i == active_idx) ? '*' : ' ');
-
-    uint16_t color = (i == selected_idx) ? UI_ST7735_VARIANT_HIGHLIGHT_COLOR
-                                         : UI_ST7735_VARIANT_NORMAL_COLOR;
-    st7735_print(lcd, UI_ST7735_MARGIN + 4, y, color, ST7735_BLACK, 1, line);
-
-    y += UI_ST7735_LINE_SPACING;
+    m->menu.bar_len[i] = ui_channel_bar_len(scores[i]);
+    ui_draw_channel_row(lcd, channels[i], m->menu.bar_len[i], i,
+                        i == selected_idx, i == active_idx);
   }
 
-  st7735_print(lcd, UI_ST7735_MARGIN + 4, y + 4, ST7735_WHITE, ST7735_BLACK, 1,
-               "#=busy *=active");
+  st7735_print(lcd, UI_ST7735_MARGIN + 4,
+               UI_ST7735_MENU_LIST_Y + count * UI_ST7735_LINE_SPACING + 4,
+               ST7735_WHITE, ST7735_BLACK, 1, "#=busy *=active");
+
+  m->menu.screen = UI_SCREEN_CHANNEL_MENU;
+  m->menu.count = count;
+  m->menu.selected_idx = selected_idx;
+  m->menu.active_idx = active_idx;
 }
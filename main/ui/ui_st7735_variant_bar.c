@@ -30,6 +30,11 @@ void ui_draw_st7735_variant_bar(UiManager *m, const SportManager *sm) {
     if (x < 0)
       x = 0;
 
+    // Boxes are collected and outlined in one batch per colour
+    St7735Rect boxes[3];
+    uint8_t normal_count = 0;
+    St7735Rect active_box = {0};
+
     for (uint8_t i = 0; i < count; i++) {
       sport_config_t cfg = get_sport_config(group->variants[i]);
 
@@ -37,8 +42,11 @@ void ui_draw_st7735_variant_bar(UiManager *m, const SportManager *sm) {
       uint16_t color = active ? UI_ST7735_VARIANT_HIGHLIGHT_COLOR
                               : UI_ST7735_VARIANT_NORMAL_COLOR;
 
-      // Draw outlined box
-      st7735_draw_rect_outline(lcd, x, y, box_w, box_h, color);
+      St7735Rect box = {x, y, box_w, box_h};
+      if (active)
+        active_box = box;
+      else
+        boxes[normal_count++] = box;
 
       // Timer text as string
       char buf[12];
@@ -55,6 +63,11 @@ void ui_draw_st7735_variant_bar(UiManager *m, const SportManager *sm) {
 
       x += box_w + spacing;
     }
+
+    st7735_draw_rect_outlines(lcd, boxes, normal_count,
+                              UI_ST7735_VARIANT_NORMAL_COLOR);
+    st7735_draw_rect_outlines(lcd, &active_box, active_idx < count ? 1 : 0,
+                              UI_ST7735_VARIANT_HIGHLIGHT_COLOR);
     return;
   }
 
@@ -71,6 +84,10 @@ void ui_draw_st7735_variant_bar(UiManager *m, const SportManager *sm) {
     if (x < 0)
       x = 0;
 
+    St7735Rect boxes[4];
+    uint8_t normal_count = 0;
+    St7735Rect active_box = {0};
+
     for (uint8_t i = 0; i < count; i++) {
       sport_config_t cfg = get_sport_config(group->variants[i]);
 
@@ -78,7 +95,11 @@ void ui_draw_st7735_variant_bar(UiManager *m, const SportManager *sm) {
       uint16_t color = active ? UI_ST7735_VARIANT_HIGHLIGHT_COLOR
                               : UI_ST7735_VARIANT_NORMAL_COLOR;
 
-      st7735_draw_rect_outline(lcd, x, y, box_w, box_h, color);
+      St7735Rect box = {x, y, box_w, box_h};
+      if (active)
+        active_box = box;
+      else
+        boxes[normal_count++] = box;
 
       char buf[12];
       snprintf(buf, sizeof(buf), "%u", cfg.play_clock_seconds);
@@ -94,6 +115,11 @@ void ui_draw_st7735_variant_bar(UiManager *m, const SportManager *sm) {
 
       x += box_w + spacing;
     }
+
+    st7735_draw_rect_outlines(lcd, boxes, normal_count,
+                              UI_ST7735_VARIANT_NORMAL_COLOR);
+    st7735_draw_rect_outlines(lcd, &active_box, active_idx < count ? 1 : 0,
+                              UI_ST7735_VARIANT_HIGHLIGHT_COLOR);
     return;
   }
 
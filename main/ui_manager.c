@@ -1,8 +1,11 @@
 #include "ui_manager.h"
 
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
 #include "freertos/task.h"
+#include "radio_config.h"
 #include "st7735_lcd.h"
 #include <stdbool.h>
 #include <stdint.h>
@@ -18,14 +21,314 @@
 static const char *TAG = "UI_MGR";
 
 // -----------------------------------------------------------------------------
-// PUBLIC API - Forwarding to specialized modules
+// RENDER COMMANDS
+//  - Posted by the control loop, executed by the render task
+//  - Everything is copied by value: main's locals change while a command
+//    waits in the queue
+// -----------------------------------------------------------------------------
+typedef enum {
+  UI_CMD_MAIN_SCREEN = 0,
+  UI_CMD_TIME,
+  UI_CMD_TIME_TENTHS,
+  UI_CMD_STATUS,
+  UI_CMD_GAME_CLOCK,
+  UI_CMD_SPORT_MENU,
+  UI_CMD_SPORT_MENU_SELECTION,
+  UI_CMD_VARIANT_MENU,
+  UI_CMD_CHANNEL_MENU,
+  UI_CMD_ALERT,
+  UI_CMD_CLEAR,
+  UI_CMD_TEST_PATTERN,
+  UI_CMD_BENCHMARK
+} UiCommandType;
+
+typedef struct {
+  UiCommandType type;
+  union {
+    struct {
+      sport_config_t sport;
+      SportManager sm;
+      uint16_t value; // seconds or deciseconds
+    } time;
+    struct {
+      bool running;
+      bool link_good;
+      uint8_t brightness_pct;
+    } status;
+    struct {
+      const sport_group_t *groups; // static tables, safe to keep by pointer
+      size_t group_count;
+      uint8_t selected_idx;
+    } sport_menu;
+    struct {
+      const sport_group_t *group;
+      uint8_t selected_idx;
+    } variant_menu;
+    struct {
+      uint8_t channels[UI_CMD_MAX_CHANNELS];
+      uint16_t scores[UI_CMD_MAX_CHANNELS];
+      uint8_t count;
+      uint8_t selected_idx;
+      uint8_t active_idx;
+    } channel_menu;
+    char alert[24];
+    char game_clock[8];
+  };
+} UiCommand;
+
+// Full-screen commands repaint everything, so anything queued before them
+// is moot
+static bool ui_cmd_is_full_screen(UiCommandType type) {
+  switch (type) {
+  case UI_CMD_MAIN_SCREEN:
+  case UI_CMD_SPORT_MENU:
+  case UI_CMD_VARIANT_MENU:
+  case UI_CMD_CHANNEL_MENU:
+  case UI_CMD_CLEAR:
+  case UI_CMD_TEST_PATTERN:
+  case UI_CMD_BENCHMARK:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Partial updates of the same screen area: only the newest one matters
+static int ui_cmd_slot(UiCommandType type) {
+  switch (type) {
+  case UI_CMD_TIME:
+  case UI_CMD_TIME_TENTHS:
+    return 1;
+  case UI_CMD_STATUS:
+    return 2;
+  case UI_CMD_SPORT_MENU_SELECTION:
+    return 3;
+  case UI_CMD_GAME_CLOCK:
+    return 4;
+  default:
+    return 0;
+  }
+}
+
+// Time-critical updates: small, and flushed ahead of any bulk repaint still
+// streaming out
+static bool ui_cmd_is_urgent(UiCommandType type) {
+  return type == UI_CMD_TIME || type == UI_CMD_TIME_TENTHS ||
+         type == UI_CMD_STATUS || type == UI_CMD_GAME_CLOCK;
+}
+
+static bool ui_cmd_superseded(const UiCommand *batch, int i, int n) {
+  // Explicit diagnostics always run, whatever is queued behind them
+  if (batch[i].type == UI_CMD_TEST_PATTERN ||
+      batch[i].type == UI_CMD_BENCHMARK)
+    return false;
+
+  int slot = ui_cmd_slot(batch[i].type);
+  for (int j = i + 1; j < n; j++) {
+    if (ui_cmd_is_full_screen(batch[j].type))
+      return true;
+    if (slot != 0 && ui_cmd_slot(batch[j].type) == slot)
+      return true;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+// RENDER BENCHMARK
+//  - Wall time includes draining the DMA, so it is the real cost of an
+//    operation; the checksum pins down what it drew
+// -----------------------------------------------------------------------------
+static int64_t ui_bench_begin(UiManager *m) {
+  st7735_wait_idle(&m->st7735);
+  st7735_stats_reset(&m->st7735);
+  return esp_timer_get_time();
+}
+
+static void ui_bench_end(UiManager *m, const char *name, int64_t start) {
+  st7735_flush(&m->st7735);
+  st7735_wait_idle(&m->st7735);
+  int64_t us = esp_timer_get_time() - start;
+
+  const St7735Stats *st = &m->st7735.stats;
+  ESP_LOGI(TAG,
+           "bench %-14s cmd=%4lu data=%6lu win=%3lu trans=%4lu %6lld us "
+           "fb=%08lx",
+           name, (unsigned long)st->commands, (unsigned long)st->data_bytes,
+           (unsigned long)st->windows, (unsigned long)st->transactions,
+           (long long)us,
+           (unsigned long)st7735_framebuffer_checksum(&m->st7735));
+}
+
+static void ui_run_benchmark(UiManager *m, const SportManager *sm) {
+  sport_config_t sport = sport_manager_get_current_sport(sm);
+  uint16_t sec = sport.play_clock_seconds;
+  int64_t t;
+
+  t = ui_bench_begin(m);
+  ui_draw_st7735_main(m, &sport, sec, sm);
+  ui_bench_end(m, "main_screen", t);
+
+  t = ui_bench_begin(m);
+  ui_st7735_update_time(m, &sport, sec - 1, sm);
+  ui_bench_end(m, "time_update", t);
+
+  t = ui_bench_begin(m);
+  ui_st7735_update_time(m, &sport, 9, sm);
+  ui_bench_end(m, "time_width", t);
+
+  t = ui_bench_begin(m);
+  ui_st7735_update_time_tenths(m, &sport, 49, sm);
+  ui_bench_end(m, "tenths_enter", t);
+
+  t = ui_bench_begin(m);
+  ui_st7735_update_time_tenths(m, &sport, 48, sm);
+  ui_bench_end(m, "tenths_tick", t);
+
+  t = ui_bench_begin(m);
+  ui_st7735_draw_status(m, true, true, 100);
+  ui_bench_end(m, "status", t);
+
+  size_t group_count;
+  const sport_group_t *groups = sport_manager_get_groups(&group_count);
+
+  t = ui_bench_begin(m);
+  ui_draw_st7735_sport_menu(m, groups, group_count, 0);
+  ui_bench_end(m, "sport_menu", t);
+
+  t = ui_bench_begin(m);
+  ui_st7735_update_sport_menu_selection(m, groups, group_count, 1);
+  ui_bench_end(m, "sport_select", t);
+
+  t = ui_bench_begin(m);
+  ui_draw_st7735_variant_menu(m, sport_manager_get_group(2), 0);
+  ui_bench_end(m, "variant_menu", t);
+
+  static const uint8_t channels[] = RADIO_CHANNEL_CANDIDATES;
+  uint16_t scores[RADIO_CHANNEL_CANDIDATE_COUNT] = {0};
+  t = ui_bench_begin(m);
+  ui_draw_st7735_channel_menu(m, channels, scores,
+                              RADIO_CHANNEL_CANDIDATE_COUNT, 0, 0);
+  ui_bench_end(m, "channel_menu", t);
+}
+
+static void ui_cmd_execute(UiManager *m, const UiCommand *c) {
+  switch (c->type) {
+  case UI_CMD_MAIN_SCREEN:
+    ui_draw_st7735_main(m, &c->time.sport, c->time.value, &c->time.sm);
+    break;
+  case UI_CMD_TIME:
+    ui_st7735_update_time(m, &c->time.sport, c->time.value, &c->time.sm);
+    break;
+  case UI_CMD_TIME_TENTHS:
+    ui_st7735_update_time_tenths(m, &c->time.sport, c->time.value,
+                                 &c->time.sm);
+    break;
+  case UI_CMD_STATUS:
+    ui_st7735_draw_status(m, c->status.running, c->status.link_good,
+                          c->status.brightness_pct);
+    break;
+  case UI_CMD_GAME_CLOCK:
+    ui_st7735_update_game_clock(m, c->game_clock);
+    break;
+  case UI_CMD_SPORT_MENU:
+    ui_draw_st7735_sport_menu(m, c->sport_menu.groups,
+                              c->sport_menu.group_count,
+                              c->sport_menu.selected_idx);
+    break;
+  case UI_CMD_SPORT_MENU_SELECTION:
+    ui_st7735_update_sport_menu_selection(m, c->sport_menu.groups,
+                                          c->sport_menu.group_count,
+                                          c->sport_menu.selected_idx);
+    break;
+  case UI_CMD_VARIANT_MENU:
+    ui_draw_st7735_variant_menu(m, c->variant_menu.group,
+                                c->variant_menu.selected_idx);
+    break;
+  case UI_CMD_CHANNEL_MENU:
+    ui_draw_st7735_channel_menu(
+        m, c->channel_menu.channels, c->channel_menu.scores,
+        c->channel_menu.count, c->channel_menu.selected_idx,
+        c->channel_menu.active_idx);
+    break;
+  case UI_CMD_ALERT:
+    st7735_print(&m->st7735, 8, 4, ST7735_RED, ST7735_BLACK, 1, c->alert);
+    break;
+  case UI_CMD_CLEAR:
+    ui_draw_st7735_blank_screen(m);
+    break;
+  case UI_CMD_TEST_PATTERN:
+    st7735_test_pattern(&m->st7735);
+    st7735_flush(&m->st7735);
+    vTaskDelay(pdMS_TO_TICKS(3000));
+    ui_draw_st7735_blank_screen(m);
+    break;
+  case UI_CMD_BENCHMARK:
+    ui_run_benchmark(m, &c->time.sm);
+    break;
+  }
+}
+
+// -----------------------------------------------------------------------------
+// RENDER TASK
+//  - Drains everything queued, skips superseded commands (e.g. several time
+//    updates that piled up behind a long menu redraw) and draws into the
+//    framebuffer
+//  - Streams at most UI_RENDER_SLICE_BYTES per pass and waits for it to hit
+//    the wire before looking at the queue again, so a clock update posted
+//    mid-repaint goes out within one slice instead of after the whole screen
+// -----------------------------------------------------------------------------
+static void ui_render_task(void *arg) {
+  UiManager *m = (UiManager *)arg;
+  UiCommand batch[UI_RENDER_QUEUE_LEN];
+
+  while (1) {
+    // Idle: sleep until posted. Repaint in progress: just poll
+    TickType_t wait = m->render_pending ? 0 : portMAX_DELAY;
+
+    int n = 0;
+    if (xQueueReceive(m->render_queue, &batch[0], wait) == pdTRUE) {
+      n = 1;
+      while (n < UI_RENDER_QUEUE_LEN &&
+             xQueueReceive(m->render_queue, &batch[n], 0) == pdTRUE)
+        n++;
+    }
+
+    for (int i = 0; i < n; i++) {
+      if (ui_cmd_superseded(batch, i, n))
+        continue;
+      bool urgent = ui_cmd_is_urgent(batch[i].type);
+      st7735_set_urgent(&m->st7735, urgent);
+      ui_cmd_execute(m, &batch[i]);
+      st7735_set_urgent(&m->st7735, false);
+    }
+
+    m->render_pending =
+        st7735_flush_budget(&m->st7735, UI_RENDER_SLICE_BYTES);
+    if (m->render_pending)
+      st7735_wait_idle(&m->st7735);
+  }
+}
+
+static void ui_post(UiManager *m, const UiCommand *c) {
+  if (xQueueSend(m->render_queue, c,
+                 pdMS_TO_TICKS(UI_RENDER_POST_TIMEOUT_MS)) != pdTRUE) {
+    ESP_LOGW(TAG, "Render queue full - dropped command %d", c->type);
+  }
+}
+
+// -----------------------------------------------------------------------------
+// PUBLIC API - Posting to the render task
 // -----------------------------------------------------------------------------
 void ui_manager_update_time(UiManager *m, const sport_config_t *sport,
                             uint16_t sec, const SportManager *sm) {
   if (!m || !m->initialized)
     return;
 
-  ui_st7735_update_time(m, sport, sec, sm);
+  UiCommand c = {.type = UI_CMD_TIME};
+  c.time.sport = *sport;
+  c.time.sm = *sm;
+  c.time.value = sec;
+  ui_post(m, &c);
 }
 
 void ui_manager_update_display(UiManager *m, const sport_config_t *sport,
@@ -33,21 +336,51 @@ void ui_manager_update_display(UiManager *m, const sport_config_t *sport,
   if (!m || !m->initialized)
     return;
 
-  ui_draw_st7735_main(m, sport, sec, sm);
+  UiCommand c = {.type = UI_CMD_MAIN_SCREEN};
+  c.time.sport = *sport;
+  c.time.sm = *sm;
+  c.time.value = sec;
+  ui_post(m, &c);
 }
 
 void ui_manager_init_st7735(UiManager *m, gpio_num_t cs, gpio_num_t dc,
                             gpio_num_t rst, gpio_num_t mosi, gpio_num_t sck) {
   ESP_LOGI(TAG, "Init ST7735");
 
+  m->render_queue = NULL;
+  m->render_task = NULL;
+  m->render_pending = 0;
+
   if (!st7735_begin(&m->st7735, cs, dc, rst, mosi, sck)) {
     ESP_LOGE(TAG, "ST7735 init FAILED");
     m->initialized = false;
     return;
   }
 
-  st7735_clear(&m->st7735, ST7735_BLACK);
-  ui_draw_st7735_frame(m);
+  // Shadow framebuffer: each UI operation becomes one or two DMA bursts
+  // instead of hundreds of per-primitive transactions. Falls back to direct
+  // drawing if the buffer can't be allocated
+  st7735_framebuffer_enable(&m->st7735);
+
+  // Digit sprites for the big clock and the variant menu rows; drawing
+  // falls back to rasterizing if memory is short
+  st7735_sprite_cache_prepare(&m->st7735, 4, ST7735_WHITE, ST7735_BLACK);
+  st7735_sprite_cache_prepare(&m->st7735, 2, ST7735_WHITE, ST7735_BLACK);
+
+  ui_draw_st7735_blank_screen(m);
+  st7735_flush(&m->st7735);
+
+  // From here on only the render task touches the display
+  m->render_queue = xQueueCreate(UI_RENDER_QUEUE_LEN, sizeof(UiCommand));
+  if (!m->render_queue ||
+      xTaskCreatePinnedToCore(ui_render_task, "ui_render",
+                              UI_RENDER_TASK_STACK, m, UI_RENDER_TASK_PRIORITY,
+                              &m->render_task,
+                              UI_RENDER_TASK_CORE) != pdPASS) {
+    ESP_LOGE(TAG, "Render task start FAILED");
+    m->initialized = false;
+    return;
+  }
 
   m->initialized = true;
 }
@@ -58,7 +391,25 @@ void ui_manager_show_sport_menu(UiManager *m, const sport_group_t *groups,
   if (!m || !m->initialized)
     return;
 
-  ui_draw_st7735_sport_menu(m, groups, group_count, selected_group_idx);
+  UiCommand c = {.type = UI_CMD_SPORT_MENU};
+  c.sport_menu.groups = groups;
+  c.sport_menu.group_count = group_count;
+  c.sport_menu.selected_idx = selected_group_idx;
+  ui_post(m, &c);
+}
+
+void ui_manager_update_sport_menu_selection(UiManager *m,
+                                            const sport_group_t *groups,
+                                            size_t group_count,
+                                            uint8_t selected_group_idx) {
+  if (!m || !m->initialized)
+    return;
+
+  UiCommand c = {.type = UI_CMD_SPORT_MENU_SELECTION};
+  c.sport_menu.groups = groups;
+  c.sport_menu.group_count = group_count;
+  c.sport_menu.selected_idx = selected_group_idx;
+  ui_post(m, &c);
 }
 
 void ui_manager_show_variant_menu(UiManager *m, const sport_group_t *group,
@@ -66,7 +417,10 @@ void ui_manager_show_variant_menu(UiManager *m, const sport_group_t *group,
   if (!m || !m->initialized)
     return;
 
-  ui_draw_st7735_variant_menu(m, group, selected_idx);
+  UiCommand c = {.type = UI_CMD_VARIANT_MENU};
+  c.variant_menu.group = group;
+  c.variant_menu.selected_idx = selected_idx;
+  ui_post(m, &c);
 }
 
 void ui_manager_show_channel_menu(UiManager *m, const uint8_t *channels,
@@ -75,8 +429,16 @@ void ui_manager_show_channel_menu(UiManager *m, const uint8_t *channels,
   if (!m || !m->initialized)
     return;
 
-  ui_draw_st7735_channel_menu(m, channels, scores, count, selected_idx,
-                              active_idx);
+  if (count > UI_CMD_MAX_CHANNELS)
+    count = UI_CMD_MAX_CHANNELS;
+
+  UiCommand c = {.type = UI_CMD_CHANNEL_MENU};
+  memcpy(c.channel_menu.channels, channels, count);
+  memcpy(c.channel_menu.scores, scores, count * sizeof(uint16_t));
+  c.channel_menu.count = count;
+  c.channel_menu.selected_idx = selected_idx;
+  c.channel_menu.active_idx = active_idx;
+  ui_post(m, &c);
 }
 
 void ui_manager_update_time_tenths(UiManager *m, const sport_config_t *sport,
@@ -85,7 +447,11 @@ void ui_manager_update_time_tenths(UiManager *m, const sport_config_t *sport,
   if (!m || !m->initialized)
     return;
 
-  ui_st7735_update_time_tenths(m, sport, deciseconds, sport_manager);
+  UiCommand c = {.type = UI_CMD_TIME_TENTHS};
+  c.time.sport = *sport;
+  c.time.sm = *sport_manager;
+  c.time.value = deciseconds;
+  ui_post(m, &c);
 }
 
 void ui_manager_draw_status(UiManager *m, bool running, bool link_good,
@@ -93,22 +459,65 @@ void ui_manager_draw_status(UiManager *m, bool running, bool link_good,
   if (!m || !m->initialized)
     return;
 
-  ui_st7735_draw_status(m, running, link_good, brightness_pct);
+  UiCommand c = {.type = UI_CMD_STATUS};
+  c.status.running = running;
+  c.status.link_good = link_good;
+  c.status.brightness_pct = brightness_pct;
+  ui_post(m, &c);
+}
+
+void ui_manager_update_game_clock(UiManager *m, const char *text) {
+  if (!m || !m->initialized || !text)
+    return;
+
+  UiCommand c = {.type = UI_CMD_GAME_CLOCK};
+  snprintf(c.game_clock, sizeof(c.game_clock), "%s", text);
+  ui_post(m, &c);
+}
+
+void ui_manager_show_alert(UiManager *m, const char *text) {
+  if (!m || !m->initialized || !text)
+    return;
+
+  UiCommand c = {.type = UI_CMD_ALERT};
+  snprintf(c.alert, sizeof(c.alert), "%s", text);
+  ui_post(m, &c);
 }
 
 void ui_manager_clear(UiManager *m) {
   if (!m || !m->initialized)
     return;
 
-  st7735_clear(&m->st7735, ST7735_BLACK);
-  ui_draw_st7735_frame(m);
+  UiCommand c = {.type = UI_CMD_CLEAR};
+  ui_post(m, &c);
 }
 
 void ui_manager_run_display_tests(UiManager *m) {
   if (!m || !m->initialized)
     return;
 
-  st7735_test_pattern(&m->st7735);
-  vTaskDelay(pdMS_TO_TICKS(3000));
-  ui_manager_clear(m);
+  // Pattern holds for 3s on the render task, then clears
+  UiCommand c = {.type = UI_CMD_TEST_PATTERN};
+  ui_post(m, &c);
+}
+
+void ui_manager_get_render_backlog(const UiManager *m,
+                                   uint32_t *queued_commands,
+                                   uint32_t *pending_bytes) {
+  *queued_commands = 0;
+  *pending_bytes = 0;
+  if (!m || !m->initialized)
+    return;
+
+  *queued_commands = uxQueueMessagesWaiting(m->render_queue);
+  *pending_bytes = m->render_pending;
+}
+
+void ui_manager_run_render_benchmark(UiManager *m, const SportManager *sm) {
+  if (!m || !m->initialized || !sm)
+    return;
+
+  UiCommand c = {.type = UI_CMD_BENCHMARK};
+  c.time.sm = *sm;
+  ui_post(m, &c);
 }
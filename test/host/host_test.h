@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stdio.h>
+
+// Minimal assertions for the host tests: a failed check is reported and
+// counted, the test keeps going so one run shows every regression
+extern int host_test_failures;
+
+#define CHECK(cond, ...)                                                       \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      host_test_failures++;                                                    \
+      fprintf(stderr, "%s:%d: CHECK(%s) failed: ", __FILE__, __LINE__, #cond); \
+      fprintf(stderr, __VA_ARGS__);                                            \
+      fputc('\n', stderr);                                                     \
+    }                                                                          \
+  } while (0)
+
+#define HOST_TEST_DEFINE_FAILURES() int host_test_failures = 0
+
+#define HOST_TEST_RESULT(name)                                                 \
+  (host_test_failures                                                          \
+       ? (fprintf(stderr, "%s: %d check(s) failed\n", name,                    \
+                  host_test_failures),                                         \
+          1)                                                                   \
+       : (printf("%s: all checks passed\n", name), 0))
@@ -0,0 +1,336 @@
+#include "panel_model.h"
+#include "driver/spi_master.h"
+#include <stdio.h>
+#include <string.h>
+
+#define PANEL_W ST7735_WIDTH
+#define PANEL_H ST7735_HEIGHT
+#define PANEL_QUEUE_LEN 64
+
+#define MADCTL_MY 0x80
+#define MADCTL_MX 0x40
+#define MADCTL_MV 0x20
+
+// How our modules sit behind the glass: upright with MY|MX (the MADCTL
+// st7735_begin() sends). Snapshots are read through this fixed mapping, so a
+// different MADCTL shows up as a mirrored or rotated image
+#define PANEL_MOUNT (MADCTL_MY | MADCTL_MX)
+
+struct spi_device_t {
+  spi_device_interface_config_t cfg;
+};
+
+static struct {
+  uint16_t gram[PANEL_H][PANEL_W]; // indexed by panel row/column
+  uint8_t levels[GPIO_NUM_MAX];
+  gpio_num_t dc;
+
+  // Command parser
+  uint8_t cmd;
+  uint8_t param[4];
+  uint8_t param_len;
+  bool in_ramwr;
+  uint8_t pixel_hi;
+  bool pixel_half;
+  uint16_t xs, xe, ys, ye;
+  uint16_t x, y;
+  uint8_t madctl;
+
+  // Queued transactions, sent as spi_device_get_trans_result() reaps them
+  spi_transaction_t *queue[PANEL_QUEUE_LEN];
+  int queue_head;
+  int queued;
+
+  int max_transfer_sz;
+  struct spi_device_t dev;
+  PanelCounters counters;
+  char last_error[96];
+} panel;
+
+static void panel_error(const char *what) {
+  panel.counters.errors++;
+  snprintf(panel.last_error, sizeof(panel.last_error), "%s (cmd 0x%02X)", what,
+           panel.cmd);
+}
+
+void panel_model_reset(gpio_num_t dc) {
+  memset(&panel, 0, sizeof(panel));
+  panel.dc = dc;
+  panel.xe = PANEL_W - 1;
+  panel.ye = PANEL_H - 1;
+}
+
+void panel_model_counters_reset(void) {
+  memset(&panel.counters, 0, sizeof(panel.counters));
+  panel.last_error[0] = '\0';
+}
+
+PanelCounters panel_model_counters(void) { return panel.counters; }
+
+const char *panel_model_last_error(void) { return panel.last_error; }
+
+// -----------------------------------------------------------------------------
+// Controller
+//  - Logical (x, y) in the CASET/RASET window goes to GRAM through MADCTL:
+//    MV swaps the axes, MX/MY mirror them
+// -----------------------------------------------------------------------------
+static void panel_map(uint8_t madctl, uint16_t x, uint16_t y, int *col,
+                      int *row) {
+  int c = x, r = y;
+  if (madctl & MADCTL_MV) {
+    c = y;
+    r = x;
+  }
+  if (madctl & MADCTL_MX)
+    c = PANEL_W - 1 - c;
+  if (madctl & MADCTL_MY)
+    r = PANEL_H - 1 - r;
+  *col = c;
+  *row = r;
+}
+
+static void panel_pixel(uint16_t color) {
+  int col, row;
+  panel_map(panel.madctl, panel.x, panel.y, &col, &row);
+  if (col < 0 || col >= PANEL_W || row < 0 || row >= PANEL_H)
+    panel_error("pixel outside GRAM");
+  else
+    panel.gram[row][col] = color;
+
+  // Row by row inside the window, wrapping to its top-left
+  if (panel.x < panel.xe) {
+    panel.x++;
+  } else {
+    panel.x = panel.xs;
+    panel.y = panel.y < panel.ye ? panel.y + 1 : panel.ys;
+  }
+}
+
+static void panel_command(uint8_t cmd) {
+  if (panel.pixel_half)
+    panel_error("odd pixel byte count");
+  panel.cmd = cmd;
+  panel.param_len = 0;
+  panel.in_ramwr = false;
+  panel.pixel_half = false;
+
+  switch (cmd) {
+  case ST7735_RAMWR:
+    panel.x = panel.xs;
+    panel.y = panel.ys;
+    panel.in_ramwr = true;
+    panel.counters.windows++;
+    break;
+  case ST7735_NOP:
+  case ST7735_SWRESET:
+  case ST7735_SLPOUT:
+  case ST7735_DISPON:
+  case ST7735_CASET:
+  case ST7735_RASET:
+  case ST7735_COLMOD:
+  case ST7735_MADCTL:
+    break;
+  default:
+    panel_error("unknown command");
+  }
+}
+
+static void panel_data(uint8_t byte) {
+  if (panel.in_ramwr) {
+    if (!panel.pixel_half) {
+      panel.pixel_hi = byte;
+      panel.pixel_half = true;
+    } else {
+      panel_pixel((uint16_t)(panel.pixel_hi << 8 | byte));
+      panel.pixel_half = false;
+    }
+    return;
+  }
+
+  if (panel.param_len >= sizeof(panel.param)) {
+    panel_error("too many parameter bytes");
+    return;
+  }
+  panel.param[panel.param_len++] = byte;
+
+  const uint8_t *p = panel.param;
+  switch (panel.cmd) {
+  case ST7735_CASET:
+  case ST7735_RASET:
+    if (panel.param_len == 4) {
+      uint16_t s = (uint16_t)(p[0] << 8 | p[1]);
+      uint16_t e = (uint16_t)(p[2] << 8 | p[3]);
+      if (s > e)
+        panel_error("window start after end");
+      if (panel.cmd == ST7735_CASET) {
+        panel.xs = s;
+        panel.xe = e;
+      } else {
+        panel.ys = s;
+        panel.ye = e;
+      }
+    }
+    break;
+  case ST7735_MADCTL:
+    panel.madctl = p[0];
+    break;
+  case ST7735_COLMOD:
+    if (p[0] != 0x05)
+      panel_error("only 16-bit colour is modelled");
+    break;
+  default:
+    panel_error("data without a command that takes any");
+  }
+}
+
+// -----------------------------------------------------------------------------
+// GPIO / SPI stubs
+// -----------------------------------------------------------------------------
+esp_err_t gpio_config(const gpio_config_t *conf) {
+  (void)conf;
+  return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio, uint32_t level) {
+  if (gpio >= 0 && gpio < GPIO_NUM_MAX)
+    panel.levels[gpio] = level ? 1 : 0;
+  return ESP_OK;
+}
+
+esp_err_t spi_bus_initialize(spi_host_device_t host,
+                             const spi_bus_config_t *bus_config, int dma_chan) {
+  (void)host;
+  (void)dma_chan;
+  panel.max_transfer_sz = bus_config->max_transfer_sz;
+  return ESP_OK;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host,
+                             const spi_device_interface_config_t *dev_config,
+                             spi_device_handle_t *handle) {
+  (void)host;
+  panel.dev.cfg = *dev_config;
+  *handle = &panel.dev;
+  return ESP_OK;
+}
+
+// The bus as the DMA sees it: bytes are read when the transfer goes out
+static void panel_transmit(spi_transaction_t *t) {
+  size_t bytes = t->length / 8;
+  if ((int)bytes > panel.max_transfer_sz)
+    panel_error("transfer above max_transfer_sz");
+  if ((t->flags & SPI_TRANS_USE_TXDATA) && bytes > 4)
+    panel_error("TXDATA transfer above 4 bytes");
+
+  if (panel.dev.cfg.pre_cb)
+    panel.dev.cfg.pre_cb(t);
+  bool dc = panel.levels[panel.dc];
+
+  const uint8_t *src = (t->flags & SPI_TRANS_USE_TXDATA)
+                           ? t->tx_data
+                           : (const uint8_t *)t->tx_buffer;
+  panel.counters.transactions++;
+  if (dc) {
+    panel.counters.data_bytes += bytes;
+    if (panel.in_ramwr)
+      panel.counters.pixel_bursts++;
+    for (size_t i = 0; i < bytes; i++)
+      panel_data(src[i]);
+  } else {
+    panel.counters.commands += bytes;
+    for (size_t i = 0; i < bytes; i++)
+      panel_command(src[i]);
+  }
+}
+
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle,
+                                 spi_transaction_t *t, uint32_t ticks_to_wait) {
+  (void)ticks_to_wait;
+  if (panel.queued == handle->cfg.queue_size ||
+      panel.queued == PANEL_QUEUE_LEN) {
+    panel_error("queued past the device queue_size");
+    return ESP_FAIL;
+  }
+
+  int tail = (panel.queue_head + panel.queued) % PANEL_QUEUE_LEN;
+  panel.queue[tail] = t;
+  panel.queued++;
+  return ESP_OK;
+}
+
+// A transfer goes on the wire when the driver reaps it: the latest moment
+// the DMA could still have been reading its buffer
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle,
+                                      spi_transaction_t **t,
+                                      uint32_t ticks_to_wait) {
+  (void)handle;
+  (void)ticks_to_wait;
+  if (panel.queued == 0)
+    return ESP_ERR_TIMEOUT;
+  *t = panel.queue[panel.queue_head];
+  panel.queue_head = (panel.queue_head + 1) % PANEL_QUEUE_LEN;
+  panel.queued--;
+  panel_transmit(*t);
+  return ESP_OK;
+}
+
+// -----------------------------------------------------------------------------
+// Snapshots
+// -----------------------------------------------------------------------------
+uint16_t panel_model_pixel(int x, int y) {
+  int col, row;
+  panel_map(PANEL_MOUNT, (uint16_t)x, (uint16_t)y, &col, &row);
+  return panel.gram[row][col];
+}
+
+static void panel_rgb888(uint16_t c, uint8_t *out) {
+  uint8_t r = (c >> 11) & 0x1F, g = (c >> 5) & 0x3F, b = c & 0x1F;
+  out[0] = (uint8_t)(r << 3 | r >> 2);
+  out[1] = (uint8_t)(g << 2 | g >> 4);
+  out[2] = (uint8_t)(b << 3 | b >> 2);
+}
+
+bool panel_model_write_ppm(const char *path) {
+  FILE *f = fopen(path, "wb");
+  if (!f)
+    return false;
+
+  fprintf(f, "P6\n%d %d\n255\n", PANEL_W, PANEL_H);
+  for (int y = 0; y < PANEL_H; y++) {
+    for (int x = 0; x < PANEL_W; x++) {
+      uint8_t rgb[3];
+      panel_rgb888(panel_model_pixel(x, y), rgb);
+      fwrite(rgb, 1, 3, f);
+    }
+  }
+  return fclose(f) == 0;
+}
+
+int panel_model_compare_ppm(const char *path) {
+  FILE *f = fopen(path, "rb");
+  if (!f)
+    return -1;
+
+  int w, h, maxval;
+  if (fscanf(f, "P6 %d %d %d", &w, &h, &maxval) != 3 || w != PANEL_W ||
+      h != PANEL_H || maxval != 255 || fgetc(f) == EOF) {
+    fclose(f);
+    return -1;
+  }
+
+  int diff = 0;
+  for (int y = 0; y < PANEL_H; y++) {
+    for (int x = 0; x < PANEL_W; x++) {
+      uint8_t want[3], got[3];
+      if (fread(want, 1, 3, f) != 3) {
+        fclose(f);
+        return -1;
+      }
+      panel_rgb888(panel_model_pixel(x, y), got);
+      if (memcmp(want, got, 3) != 0)
+        diff++;
+    }
+  }
+  fclose(f);
+  return diff;
+}
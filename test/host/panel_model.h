@@ -0,0 +1,43 @@
+#pragma once
+
+#include "driver/gpio.h"
+#include "st7735_lcd.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// In-memory ST7735 behind the host SPI/GPIO stubs. Every queued transaction
+// runs through the device's pre_cb (which drives DC, as on the target) and
+// is interpreted byte by byte: CASET/RASET set the window, RAMWR streams
+// RGB565 pixels into a 128x160 GRAM through the MADCTL address mapping.
+// A transfer is sent when the driver reaps it, the latest moment the DMA
+// could have read its buffer, so a buffer reused too early shows up as
+// wrong pixels. Call st7735_wait_idle() before reading the panel
+
+// What actually crossed the bus since the last panel_model_counters_reset()
+typedef struct {
+  uint32_t commands;     // command bytes (DC low)
+  uint32_t data_bytes;   // parameter + pixel bytes (DC high)
+  uint32_t windows;      // RAMWR commands
+  uint32_t transactions; // queued SPI transactions
+  uint32_t pixel_bursts; // transactions carrying pixel data
+  uint32_t errors;       // protocol errors (see panel_model_last_error())
+} PanelCounters;
+
+// Power-on state: GRAM black, counters cleared. dc is the pin st7735_begin()
+// gets as its DC line
+void panel_model_reset(gpio_num_t dc);
+
+void panel_model_counters_reset(void);
+PanelCounters panel_model_counters(void);
+const char *panel_model_last_error(void);
+
+// Image as seen through the glass of our modules (mounted for MADCTL MY|MX):
+// a different MADCTL shows up mirrored or rotated
+uint16_t panel_model_pixel(int x, int y);
+
+// Binary PPM (P6), 8 bits per channel
+bool panel_model_write_ppm(const char *path);
+
+// Compare against a PPM written by panel_model_write_ppm(). Returns the
+// number of differing pixels (-1 = missing or unreadable file)
+int panel_model_compare_ppm(const char *path);
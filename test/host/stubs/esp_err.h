@@ -0,0 +1,9 @@
+#pragma once
+
+// Host build: the subset of ESP-IDF the tested modules use
+
+typedef int esp_err_t;
+
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_TIMEOUT 0x107
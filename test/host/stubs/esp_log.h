@@ -0,0 +1,12 @@
+#pragma once
+
+#include <stdio.h>
+
+// Warnings and errors go to stderr (a test that trips one should show why);
+// info and below are dropped
+#define ESP_LOGE(tag, fmt, ...)                                                \
+  fprintf(stderr, "E %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...)                                                \
+  fprintf(stderr, "W %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) ((void)(tag))
+#define ESP_LOGD(tag, fmt, ...) ((void)(tag))
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+typedef void *TaskHandle_t;
+
+// Host build: nothing to wait for (the panel model completes transfers at
+// once)
+static inline void vTaskDelay(TickType_t ticks) { (void)ticks; }
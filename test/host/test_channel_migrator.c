@@ -0,0 +1,228 @@
+// ChannelMigrator replayed against occupancy/success traces at the TX
+// task's evaluation rate (RADIO_MIGRATE_EVAL_MS = 1 s): thresholds and
+// their boundaries, the degradation hold and its restart on a clean
+// sample, the target margin, and the rate limit after any change
+#include "channel_migrator.h"
+#include "host_test.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+HOST_TEST_DEFINE_FAILURES();
+
+#define EVAL_MS 1000
+#define CANDIDATES 6
+#define MAX_MIGRATIONS 8
+
+// One segment of a trace: every candidate's occupancy and the windowed TX
+// success for `seconds` evaluations. Occupancy is per candidate, so it
+// follows the controller when it migrates
+typedef struct {
+  uint32_t seconds;
+  uint8_t busy_pct[CANDIDATES];
+  int16_t success_pct;
+} TraceStep;
+
+typedef struct {
+  int count;
+  uint32_t at_ms[MAX_MIGRATIONS];
+  uint8_t to[MAX_MIGRATIONS];
+} Migrations;
+
+// Runs the trace from t = 0 on candidate 0, as the TX task does: one step
+// per evaluation, the active index moved on every returned target.
+// change_at_zero: the boot pick counts as a change (what radio_tx_start()
+// does), so nothing moves in the first minute
+static Migrations replay(const TraceStep *trace, int steps,
+                         bool change_at_zero) {
+  ChannelMigrator m;
+  channel_migrator_init(&m, NULL);
+  if (change_at_zero)
+    channel_migrator_note_change(&m, 0);
+
+  Migrations out = {0};
+  uint8_t active = 0;
+  uint32_t now = 0;
+  for (int i = 0; i < steps; i++) {
+    for (uint32_t s = 0; s < trace[i].seconds; s++, now += EVAL_MS) {
+      ChannelMigratorInput in = {.busy_pct = trace[i].busy_pct,
+                                 .count = CANDIDATES,
+                                 .active_idx = active,
+                                 .success_pct = trace[i].success_pct};
+      int target = channel_migrator_step(&m, &in, now);
+      if (target < 0)
+        continue;
+      if (out.count < MAX_MIGRATIONS) {
+        out.at_ms[out.count] = now;
+        out.to[out.count] = (uint8_t)target;
+      }
+      out.count++;
+      active = (uint8_t)target;
+    }
+  }
+  CHECK(m.migrations == out.count, "migrator counted %u migrations, saw %d",
+        m.migrations, out.count);
+  return out;
+}
+
+#define REPLAY(trace, change_at_zero)                                          \
+  replay(trace, (int)(sizeof(trace) / sizeof(trace[0])), change_at_zero)
+
+// -----------------------------------------------------------------------------
+// Traces
+// -----------------------------------------------------------------------------
+static void test_clean_channel_stays(void) {
+  static const TraceStep trace[] = {
+      {600, {10, 5, 5, 5, 5, 5}, 100},
+      {60, {34, 0, 0, 0, 0, 0}, 80}, // just under both thresholds
+      {60, {0, 0, 0, 0, 0, 0}, -1},  // no ticks in the window: not degraded
+  };
+  Migrations got = REPLAY(trace, false);
+  CHECK(got.count == 0, "clean channel migrated %d times (first at %u ms)",
+        got.count, got.at_ms[0]);
+}
+
+static void test_hold_then_quietest(void) {
+  static const TraceStep trace[] = {
+      {10, {10, 5, 5, 5, 5, 5}, 100},
+      {30, {50, 20, 12, 30, 12, 40}, 100}, // 2 and 4 tie: list order wins
+  };
+  Migrations got = REPLAY(trace, false);
+  CHECK(got.count == 1, "expected one migration, got %d", got.count);
+  // Degraded from the sample at 10 s, held for 5 s
+  CHECK(got.at_ms[0] == 10000 + CHANNEL_MIGRATE_HOLD_MS,
+        "migrated at %u ms, expected %u", got.at_ms[0],
+        10000 + CHANNEL_MIGRATE_HOLD_MS);
+  CHECK(got.to[0] == 2, "migrated to candidate %u, expected 2", got.to[0]);
+}
+
+static void test_busy_boundary(void) {
+  static const TraceStep at[] = {{10, {35, 0, 0, 0, 0, 0}, 100}};
+  static const TraceStep below[] = {{10, {34, 0, 0, 0, 0, 0}, 100}};
+  CHECK(REPLAY(at, false).count == 1, "busy at the threshold did not migrate");
+  CHECK(REPLAY(below, false).count == 0, "busy below the threshold migrated");
+}
+
+static void test_success_degraded(void) {
+  // Quiet by occupancy but losing ticks: moves if somewhere is clearly
+  // quieter, stays if the band is uniformly quiet
+  static const TraceStep move[] = {{10, {30, 5, 5, 5, 5, 5}, 79}};
+  static const TraceStep stay[] = {{10, {10, 5, 5, 5, 5, 5}, 60}};
+  static const TraceStep boundary[] = {{10, {30, 5, 5, 5, 5, 5}, 80}};
+  Migrations got = REPLAY(move, false);
+  CHECK(got.count == 1 && got.at_ms[0] == CHANNEL_MIGRATE_HOLD_MS,
+        "low success: %d migrations, first at %u ms", got.count, got.at_ms[0]);
+  CHECK(REPLAY(stay, false).count == 0,
+        "low success on a uniformly quiet band migrated");
+  CHECK(REPLAY(boundary, false).count == 0,
+        "success at the threshold migrated");
+}
+
+static void test_flapping_never_holds(void) {
+  // Degraded 4 s out of every 5: never HOLD_MS without a clean sample
+  TraceStep trace[2 * 60];
+  for (int i = 0; i < 60; i++) {
+    trace[2 * i] = (TraceStep){4, {60, 0, 0, 0, 0, 0}, 100};
+    trace[2 * i + 1] = (TraceStep){1, {10, 0, 0, 0, 0, 0}, 100};
+  }
+  Migrations got = REPLAY(trace, false);
+  CHECK(got.count == 0, "flapping channel migrated at %u ms", got.at_ms[0]);
+
+  // Degraded samples spanning the full hold, and it goes
+  trace[0] = (TraceStep){6, {60, 0, 0, 0, 0, 0}, 100};
+  got = replay(trace, 1, false);
+  CHECK(got.count == 1 && got.at_ms[0] == CHANNEL_MIGRATE_HOLD_MS,
+        "5 s degraded: %d migrations, first at %u ms", got.count,
+        got.at_ms[0]);
+}
+
+static void test_margin(void) {
+  static const TraceStep short_of[] = {{10, {40, 21, 30, 30, 30, 30}, 100}};
+  static const TraceStep exact[] = {{10, {40, 20, 30, 30, 30, 30}, 100}};
+  static const TraceStep band_busy[] = {{60, {70, 60, 55, 65, 60, 58}, 40}};
+  CHECK(REPLAY(short_of, false).count == 0,
+        "migrated to a target only 19 points quieter");
+  CHECK(REPLAY(exact, false).count == 1,
+        "did not migrate to a target exactly the margin quieter");
+  CHECK(REPLAY(band_busy, false).count == 0,
+        "hopped between equally busy channels");
+}
+
+static void test_rate_limit(void) {
+  // Boot pick at 0: degraded from the start, first move at the minute
+  static const TraceStep boot[] = {{90, {60, 5, 5, 5, 5, 5}, 100}};
+  Migrations got = REPLAY(boot, true);
+  CHECK(got.count == 1 && got.at_ms[0] == CHANNEL_MIGRATE_MIN_INTERVAL_MS,
+        "after the boot pick: %d migrations, first at %u ms", got.count,
+        got.at_ms[0]);
+
+  // Interference that follows the controller: the channel it lands on
+  // degrades right after the move, so it moves again, but only once the
+  // minute since the last move is up
+  static const TraceStep chase[] = {
+      {10, {60, 5, 5, 5, 5, 5}, 100},
+      {200, {60, 60, 5, 5, 5, 5}, 100},
+  };
+  got = REPLAY(chase, false);
+  CHECK(got.count == 2, "expected two migrations, got %d", got.count);
+  CHECK(got.at_ms[0] == CHANNEL_MIGRATE_HOLD_MS && got.to[0] == 1,
+        "first move at %u ms to %u", got.at_ms[0], got.to[0]);
+  CHECK(got.at_ms[1] == got.at_ms[0] + CHANNEL_MIGRATE_MIN_INTERVAL_MS &&
+            got.to[1] == 2,
+        "second move at %u ms to %u, expected %u ms", got.at_ms[1], got.to[1],
+        got.at_ms[0] + CHANNEL_MIGRATE_MIN_INTERVAL_MS);
+}
+
+static void test_manual_change_restarts(void) {
+  // A manual pick in the middle of a degradation restarts both the hold
+  // and the rate limit
+  ChannelMigrator m;
+  channel_migrator_init(&m, NULL);
+  static const uint8_t busy[CANDIDATES] = {60, 5, 5, 5, 5, 5};
+  ChannelMigratorInput in = {.busy_pct = busy,
+                             .count = CANDIDATES,
+                             .active_idx = 0,
+                             .success_pct = 100};
+  uint32_t now = 0;
+  for (; now < 4000; now += EVAL_MS)
+    CHECK(channel_migrator_step(&m, &in, now) < 0, "moved at %u ms", now);
+  channel_migrator_note_change(&m, now);
+  uint32_t picked = now;
+  int target = -1;
+  for (; now < picked + 2 * CHANNEL_MIGRATE_MIN_INTERVAL_MS && target < 0;
+       now += EVAL_MS)
+    target = channel_migrator_step(&m, &in, now);
+  now -= EVAL_MS;
+  CHECK(target == 1 && now == picked + CHANNEL_MIGRATE_MIN_INTERVAL_MS,
+        "after a manual pick at %u ms: target %d at %u ms", picked, target,
+        now);
+}
+
+static void test_bad_input(void) {
+  ChannelMigrator m;
+  channel_migrator_init(&m, NULL);
+  static const uint8_t busy[CANDIDATES] = {90, 0, 0, 0, 0, 0};
+  ChannelMigratorInput one = {
+      .busy_pct = busy, .count = 1, .active_idx = 0, .success_pct = 0};
+  ChannelMigratorInput off_list = {
+      .busy_pct = busy, .count = CANDIDATES, .active_idx = 7, .success_pct = 0};
+  for (uint32_t now = 0; now < 20000; now += EVAL_MS) {
+    CHECK(channel_migrator_step(&m, &one, now) < 0,
+          "migrated with a single candidate");
+    CHECK(channel_migrator_step(&m, &off_list, now) < 0,
+          "migrated from an active index off the list");
+  }
+}
+
+int main(void) {
+  test_clean_channel_stays();
+  test_hold_then_quietest();
+  test_busy_boundary();
+  test_success_degraded();
+  test_flapping_never_holds();
+  test_margin();
+  test_rate_limit();
+  test_manual_change_restarts();
+  test_bad_input();
+  return HOST_TEST_RESULT("channel_migrator");
+}
@@ -0,0 +1,135 @@
+// The frame loss benchmark (radio_frame_loss_benchmark) run at 0-50% loss
+// over the same seeds as the boot benchmark. Prints the table it logs on the
+// target and checks what the extended stream is for: a free-running clock
+// display stays right where a legacy one freezes on lost ticks, while a
+// legacy display fed extended frames shows garbage (hence their opt-in)
+#include "host_test.h"
+#include "radio_frame.h"
+#include "radio_tx_cadence.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+HOST_TEST_DEFINE_FAILURES();
+
+#define SEEDS 8 // RADIO_FRAME_BENCHMARK_SEEDS in main.c
+#define CLOCK_WRONG_MAX_PCT 1.0
+
+typedef struct {
+  uint32_t ticks, ticks_lost, sim_ms;
+  uint32_t legacy_wrong, mixed_wrong, clock_wrong;
+  uint32_t legacy_max, clock_max;
+} LossTotals;
+
+// The controller's own cadence (radio_tx_cadence.h), as main.c passes it
+static RadioFrameLossCadence default_cadence(void) {
+  const RadioTxPolicy policy = RADIO_TX_POLICY_DEFAULT;
+  return (RadioFrameLossCadence){
+      .active_keepalive_ms = policy.active_keepalive_ms,
+      .idle_keepalive_ms = policy.idle_keepalive_ms,
+      .epoch_fast_ms = RADIO_TX_EPOCH_FAST_MS,
+  };
+}
+
+static LossTotals run_level(const RadioFrameLossCadence *cadence,
+                            uint8_t loss) {
+  LossTotals t = {0};
+  for (uint32_t seed = 1; seed <= SEEDS; seed++) {
+    RadioFrameLossResult r;
+    radio_frame_loss_benchmark(cadence, loss, seed * 2654435761u, &r);
+    CHECK(r.loss_pct == loss, "result for %u%% reports %u%%", loss,
+          r.loss_pct);
+    t.ticks += r.ticks;
+    t.ticks_lost += r.ticks_lost;
+    t.sim_ms += r.sim_ms;
+    t.legacy_wrong += r.legacy_wrong_ms;
+    t.mixed_wrong += r.mixed_wrong_ms;
+    t.clock_wrong += r.clock_wrong_ms;
+    if (r.legacy_max_err_ms > t.legacy_max)
+      t.legacy_max = r.legacy_max_err_ms;
+    if (r.clock_max_err_ms > t.clock_max)
+      t.clock_max = r.clock_max_err_ms;
+  }
+  return t;
+}
+
+static double pct(uint32_t part, uint32_t whole) {
+  return whole ? part * 100.0 / whole : 0.0;
+}
+
+// -----------------------------------------------------------------------------
+// Loss levels
+// -----------------------------------------------------------------------------
+static void test_loss_levels(void) {
+  const RadioFrameLossCadence cadence = default_cadence();
+  printf("%-5s %7s %8s %9s %8s %9s %8s\n", "loss", "lost", "legacy",
+         "max ms", "clock", "max ms", "mixed");
+  for (uint8_t loss = 0; loss <= 50; loss += 10) {
+    LossTotals t = run_level(&cadence, loss);
+    double lost = pct(t.ticks_lost, t.ticks);
+    double legacy = pct(t.legacy_wrong, t.sim_ms);
+    double clock = pct(t.clock_wrong, t.sim_ms);
+    double mixed = pct(t.mixed_wrong, t.sim_ms);
+    printf("%3u%%  %6.1f%% %7.1f%% %9u %7.1f%% %9u %7.1f%%\n", loss, lost,
+           legacy, t.legacy_max, clock, t.clock_max, mixed);
+
+    CHECK(t.ticks > 0 && t.sim_ms > 0, "%u%%: nothing simulated", loss);
+    // The drop is deterministic but should still track the asked rate
+    CHECK(lost >= loss - 5.0 && lost <= loss + 5.0,
+          "%u%%: %.1f%% of ticks dropped", loss, lost);
+    if (loss == 0) {
+      CHECK(t.ticks_lost == 0, "0%%: %u ticks dropped", t.ticks_lost);
+      CHECK(t.legacy_wrong == 0 && t.clock_wrong == 0,
+            "0%%: displays wrong without loss (legacy %u ms, clock %u ms)",
+            t.legacy_wrong, t.clock_wrong);
+    } else {
+      CHECK(t.legacy_wrong > 0, "%u%%: legacy display never wrong", loss);
+    }
+    CHECK(t.clock_wrong <= t.legacy_wrong,
+          "%u%%: clock display wrong %.1f%% vs legacy %.1f%%", loss, clock,
+          legacy);
+    CHECK(clock < CLOCK_WRONG_MAX_PCT, "%u%%: clock display wrong %.1f%%",
+          loss, clock);
+    // A legacy display reading clock frames as times is wrong nearly always
+    CHECK(mixed >= 95.0, "%u%%: legacy display with extended frames only "
+                         "wrong %.1f%%",
+          loss, mixed);
+  }
+}
+
+// The cadence passed in is the one replayed: re-airing less often leaves a
+// legacy display on a lost tick longer
+static void test_cadence(void) {
+  const RadioFrameLossCadence fast = default_cadence();
+  RadioFrameLossCadence slow = fast;
+  slow.active_keepalive_ms = RADIO_RX_STALE_BOUND_MS;
+  slow.idle_keepalive_ms = RADIO_RX_STALE_BOUND_MS;
+
+  LossTotals f = run_level(&fast, 30);
+  LossTotals s = run_level(&slow, 30);
+  CHECK(s.ticks < f.ticks, "slow keep-alive aired %u ticks, default %u",
+        s.ticks, f.ticks);
+  CHECK(s.legacy_wrong > f.legacy_wrong,
+        "slow keep-alive legacy wrong %u ms, default %u ms", s.legacy_wrong,
+        f.legacy_wrong);
+}
+
+static void test_deterministic(void) {
+  const RadioFrameLossCadence cadence = default_cadence();
+  RadioFrameLossResult a, b;
+  radio_frame_loss_benchmark(&cadence, 30, 12345, &a);
+  radio_frame_loss_benchmark(&cadence, 30, 12345, &b);
+  CHECK(memcmp(&a, &b, sizeof(a)) == 0, "same seed, different results");
+
+  // Seed 0 is remapped, not a stuck generator
+  radio_frame_loss_benchmark(&cadence, 30, 0, &a);
+  CHECK(a.ticks_lost > 0 && a.ticks_lost < a.ticks,
+        "seed 0 dropped %u of %u ticks", a.ticks_lost, a.ticks);
+}
+
+int main(void) {
+  test_loss_levels();
+  test_cadence();
+  test_deterministic();
+  return HOST_TEST_RESULT("radio_frame_loss");
+}
@@ -0,0 +1,207 @@
+// Channel following (RadioFrameRx) against the frames the TX task airs for
+// a switch: every tick of the announcement window carries the time frame,
+// then the announcement with the same sequence, and the tick carrying the
+// switch sequence N is the last on the old channel. Whatever subset of
+// those frames a receiver hears, it must end up on the new channel: right
+// after the first frame with sequence >= N, or on the hop timeout
+#include "host_test.h"
+#include "radio_frame.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+HOST_TEST_DEFINE_FAILURES();
+
+#define OLD_CHANNEL 76
+#define NEW_CHANNEL 49
+#define TICK_MS 250 // active keep-alive: announcement ticks go out at it
+
+static RadioFrame decode(const uint8_t *payload) {
+  RadioFrame frame;
+  radio_frame_decode(payload, &frame);
+  return frame;
+}
+
+static RadioFrame time_frame(uint8_t sequence) {
+  uint8_t payload[RADIO_FRAME_SIZE];
+  radio_frame_encode_time(payload, 24, 0, 255, 0, sequence);
+  return decode(payload);
+}
+
+static RadioFrame switch_frame(uint8_t target, uint8_t switch_sequence,
+                               uint8_t sequence) {
+  uint8_t payload[RADIO_FRAME_SIZE];
+  radio_frame_encode_switch(payload, target, switch_sequence, sequence);
+  return decode(payload);
+}
+
+// -----------------------------------------------------------------------------
+// Encoding
+// -----------------------------------------------------------------------------
+static void test_switch_encoding(void) {
+  uint8_t payload[RADIO_FRAME_SIZE];
+  radio_frame_encode_switch(payload, NEW_CHANNEL, 200, 197);
+  RadioFrame frame = decode(payload);
+  CHECK(frame.type == RADIO_FRAME_SWITCH, "announcement decodes as %d",
+        frame.type);
+  CHECK(frame.target_channel == NEW_CHANNEL && frame.switch_sequence == 200 &&
+            frame.sequence == 197,
+        "announcement fields: channel %u switch seq %u seq %u",
+        frame.target_channel, frame.switch_sequence, frame.sequence);
+
+  // One corrupted field must not turn into a hop somewhere else
+  for (int byte = 1; byte <= 4; byte++) {
+    uint8_t bad[RADIO_FRAME_SIZE];
+    for (int i = 0; i < RADIO_FRAME_SIZE; i++)
+      bad[i] = payload[i];
+    bad[byte] ^= 0x01;
+    CHECK(decode(bad).type == RADIO_FRAME_INVALID,
+          "announcement with byte %d flipped still decodes", byte);
+  }
+
+  // Time frames never carry the marker in their high byte
+  for (uint32_t v = 0; v <= 0xFFFF; v++) {
+    uint8_t hi = v >> 8;
+    if (hi != 0x00 && hi != 0x01 && hi != 0x80 && hi != 0x81)
+      continue;
+    radio_frame_encode_time(payload, (uint16_t)v, 1, 2, 3, 4);
+    RadioFrame t = decode(payload);
+    CHECK(t.type == RADIO_FRAME_TIME && t.time_value == v,
+          "time value 0x%04X decodes as type %d value 0x%04X", (unsigned)v,
+          t.type, t.time_value);
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Announcement window under loss
+// -----------------------------------------------------------------------------
+// Replays one switch starting at first_sequence. heard bit 2k: time frame of
+// tick k, bit 2k+1: its announcement. Returns the ms (from the first tick)
+// at which the receiver hopped, -1 if it never did
+static int replay_switch(uint8_t first_sequence, uint32_t heard) {
+  RadioFrameRx rx;
+  radio_frame_rx_init(&rx, OLD_CHANNEL);
+  uint8_t n = (uint8_t)(first_sequence + RADIO_SWITCH_ANNOUNCE_TICKS - 1);
+
+  uint32_t now = 1000;
+  for (int k = 0; k < RADIO_SWITCH_ANNOUNCE_TICKS; k++, now += TICK_MS) {
+    uint8_t sequence = (uint8_t)(first_sequence + k);
+    RadioFrame t = time_frame(sequence);
+    RadioFrame a = switch_frame(NEW_CHANNEL, n, sequence);
+    if ((heard & (1u << (2 * k))) && radio_frame_rx_feed(&rx, &t, now))
+      return (int)(now - 1000);
+    if ((heard & (1u << (2 * k + 1))) && radio_frame_rx_feed(&rx, &a, now))
+      return (int)(now - 1000);
+    if (radio_frame_rx_poll(&rx, now))
+      return (int)(now - 1000);
+  }
+
+  // The controller has hopped: nothing more on the old channel, the
+  // receiver only polls
+  for (; now < 1000 + 4 * RADIO_SWITCH_HOP_TIMEOUT_MS; now += 10) {
+    if (radio_frame_rx_poll(&rx, now))
+      return rx.channel == NEW_CHANNEL ? (int)(now - 1000) : -2;
+  }
+  return -1;
+}
+
+static void test_reacquire_under_loss(void) {
+  const int last_tick_ms = (RADIO_SWITCH_ANNOUNCE_TICKS - 1) * TICK_MS;
+  const uint32_t patterns = 1u << (2 * RADIO_SWITCH_ANNOUNCE_TICKS);
+
+  // Sequences far from and across the 8-bit wrap
+  static const uint8_t starts[] = {10, 253, 254, 255};
+  for (size_t s = 0; s < sizeof(starts); s++) {
+    for (uint32_t heard = 0; heard < patterns; heard++) {
+      int hop = replay_switch(starts[s], heard);
+      bool any_announcement = false;
+      int first_heard_ms = -1;
+      for (int k = 0; k < RADIO_SWITCH_ANNOUNCE_TICKS; k++) {
+        if (heard & (1u << (2 * k + 1))) {
+          any_announcement = true;
+          if (first_heard_ms < 0)
+            first_heard_ms = k * TICK_MS;
+        }
+      }
+      const int last = RADIO_SWITCH_ANNOUNCE_TICKS - 1;
+      bool last_time = heard & (1u << (2 * last));
+      bool last_announcement = heard & (1u << (2 * last + 1));
+      bool pending_before_last = first_heard_ms < last_tick_ms;
+
+      if (!any_announcement) {
+        // Nothing announced reached it: left to scanning, never hops
+        CHECK(hop == -1, "start %u heard 0x%02X: hopped at %d ms without an "
+                         "announcement",
+              starts[s], heard, hop);
+        continue;
+      }
+      CHECK(hop >= 0, "start %u heard 0x%02X: never re-acquired (%d)",
+            starts[s], heard, hop);
+      if (last_announcement || (pending_before_last && last_time)) {
+        // Switch pending and a frame of the last tick heard: hops right
+        // there, together with the controller
+        CHECK(hop == last_tick_ms, "start %u heard 0x%02X: hopped at %d ms, "
+                                   "expected with the last tick (%d ms)",
+              starts[s], heard, hop, last_tick_ms);
+      } else {
+        CHECK(hop == first_heard_ms + RADIO_SWITCH_HOP_TIMEOUT_MS,
+              "start %u heard 0x%02X: hopped at %d ms, expected the timeout "
+              "(%d ms)",
+              starts[s], heard, hop,
+              first_heard_ms + RADIO_SWITCH_HOP_TIMEOUT_MS);
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Corner cases
+// -----------------------------------------------------------------------------
+static void test_corner_cases(void) {
+  RadioFrameRx rx;
+
+  // An announcement for the channel we are on is not a switch
+  radio_frame_rx_init(&rx, OLD_CHANNEL);
+  RadioFrame a = switch_frame(OLD_CHANNEL, 20, 20);
+  CHECK(!radio_frame_rx_feed(&rx, &a, 0) && !rx.switch_pending,
+        "announcement for the current channel started a switch");
+  CHECK(!radio_frame_rx_poll(&rx, 10 * RADIO_SWITCH_HOP_TIMEOUT_MS),
+        "poll hopped without a pending switch");
+
+  // A later announcement replaces the target, the timeout still runs from
+  // the first one heard
+  radio_frame_rx_init(&rx, OLD_CHANNEL);
+  a = switch_frame(NEW_CHANNEL, 40, 37);
+  radio_frame_rx_feed(&rx, &a, 100);
+  a = switch_frame(24, 44, 41);
+  radio_frame_rx_feed(&rx, &a, 600);
+  CHECK(!radio_frame_rx_poll(&rx, 100 + RADIO_SWITCH_HOP_TIMEOUT_MS - 1),
+        "hopped before the timeout");
+  CHECK(radio_frame_rx_poll(&rx, 100 + RADIO_SWITCH_HOP_TIMEOUT_MS) &&
+            rx.channel == 24,
+        "replaced switch ended on channel %u", rx.channel);
+
+  // Invalid frames neither start nor complete a switch
+  radio_frame_rx_init(&rx, OLD_CHANNEL);
+  a = switch_frame(NEW_CHANNEL, 50, 48);
+  radio_frame_rx_feed(&rx, &a, 0);
+  RadioFrame invalid = {.type = RADIO_FRAME_INVALID, .sequence = 60};
+  CHECK(!radio_frame_rx_feed(&rx, &invalid, 10) && rx.switch_pending,
+        "an invalid frame completed the switch");
+
+  // Right after the hop the receiver is idle on the new channel
+  RadioFrame t = time_frame(50);
+  CHECK(radio_frame_rx_feed(&rx, &t, 20) && rx.channel == NEW_CHANNEL &&
+            !rx.switch_pending,
+        "time frame N did not complete the switch");
+  t = time_frame(51);
+  CHECK(!radio_frame_rx_feed(&rx, &t, 30), "hopped again on channel %u",
+        rx.channel);
+}
+
+int main(void) {
+  test_switch_encoding();
+  test_reacquire_under_loss();
+  test_corner_cases();
+  return HOST_TEST_RESULT("radio_frame_rx");
+}
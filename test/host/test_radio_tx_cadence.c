@@ -0,0 +1,333 @@
+// The TX task's cadence (radio_tx_cadence.h) replayed against a TimerManager
+// on the fake clock: paused, running through the final window to zero and
+// the null signal, stop/start epochs and channel switches, announced or
+// not. The task wakes at its own deadlines and whenever the control loop
+// publishes (an input, or the clock's next visible change). A receiver that
+// hears every tick must never go longer than RADIO_RX_STALE_BOUND_MS
+// without one, and the final seconds must carry the boosted copy count
+#include "host_test.h"
+#include "radio_frame.h"
+#include "radio_tx_cadence.h"
+#include "timer_manager.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+HOST_TEST_DEFINE_FAILURES();
+
+#define MS 1000LL
+#define BOUND_US ((int64_t)RADIO_RX_STALE_BOUND_MS * MS)
+
+typedef enum {
+  EV_START,
+  EV_STOP,
+  EV_RESET,  // to `seconds`, stopped or not
+  EV_SWITCH, // radio_tx_request_channel()
+} EventType;
+
+typedef struct {
+  uint32_t at_ms;
+  EventType type;
+  uint16_t seconds;
+} Event;
+
+typedef struct {
+  uint32_t ticks;
+  int64_t max_silence_us;
+  int64_t max_running_gap_us; // between ticks while counting down
+  int64_t max_switch_gap_us;  // between announcement ticks
+  uint32_t hops;
+  int64_t hop_silence_us; // last tick on the old channel to first on the new
+  uint32_t final_ticks;   // inside the final window
+  uint32_t final_short;   // of those, aired without final_copies
+  uint32_t boosted_outside; // final_copies outside the window
+  uint32_t late;          // deadline after the clock's next visible change
+  int64_t null_due_us;    // should_send_null() first true (-1 = never)
+  int64_t null_aired_us;  // first tick carrying it (-1 = never)
+} Replay;
+
+// The TX task's loop around the cadence, minus the radio: the switch
+// request is taken at a wake-up, an announced switch hops after the
+// RADIO_SWITCH_ANNOUNCE_TICKS-th aired tick and airs at once on the new
+// channel. control_loop: also wake at the control loop's publishes
+static Replay replay(const RadioTxPolicy *p, const Event *ev, int count,
+                     uint32_t end_ms, bool control_loop) {
+  TimerFakeClock fake;
+  TimerManager tm;
+  timer_manager_init(&tm, 24, timer_fake_clock_init(&fake, 0));
+  RadioTxCadence cadence;
+  radio_tx_cadence_init(&cadence);
+
+  Replay r = {.null_due_us = -1, .null_aired_us = -1};
+  int64_t now = 0, last_tick = -1, last_switch_tick = -1;
+  int next = 0;
+  bool switch_requested = false, prev_running = false, prev_null = false;
+  bool last_tick_counting = false;
+  uint8_t ticks_left = 0;
+
+  while (now <= (int64_t)end_ms * MS) {
+    // Inputs at this instant, as the control loop applies them
+    for (; next < count && (int64_t)ev[next].at_ms * MS <= now; next++) {
+      switch (ev[next].type) {
+      case EV_START:
+        timer_manager_start(&tm);
+        break;
+      case EV_STOP:
+        timer_manager_stop(&tm);
+        break;
+      case EV_RESET:
+        timer_manager_reset(&tm, ev[next].seconds);
+        break;
+      case EV_SWITCH:
+        switch_requested = true;
+        break;
+      }
+    }
+    timer_manager_update(&tm);
+
+    if (switch_requested) {
+      switch_requested = false;
+      if (p->extended_frames) {
+        ticks_left = RADIO_SWITCH_ANNOUNCE_TICKS;
+      } else {
+        r.hops++; // at once; the forced tick is the first on the new channel
+        r.hop_silence_us = last_tick < 0 ? 0 : now - last_tick;
+      }
+      radio_tx_cadence_force(&cadence);
+    }
+
+    bool running = timer_manager_is_running(&tm);
+    bool send_null = timer_manager_should_send_null(&tm);
+    if (send_null && r.null_due_us < 0)
+      r.null_due_us = now;
+    RadioTxTick tick = {
+        .now_us = now,
+        .rem_us = (uint32_t)timer_manager_get_remaining_us(&tm),
+        .running = running,
+        .send_null = send_null,
+        .color = {255, 90, 0},
+        .new_epoch = running != prev_running || send_null != prev_null,
+        .switching = ticks_left > 0,
+    };
+    prev_running = running;
+    prev_null = send_null;
+
+    RadioTxPlan plan;
+    radio_tx_cadence_plan(&cadence, p, &tick, &plan);
+    bool hopped = false;
+    if (plan.air) {
+      r.ticks++;
+      bool counting = running && tick.rem_us > 0 && !send_null;
+      if (last_tick >= 0) {
+        int64_t gap = now - last_tick;
+        if (gap > r.max_silence_us)
+          r.max_silence_us = gap;
+        if (counting && last_tick_counting && gap > r.max_running_gap_us)
+          r.max_running_gap_us = gap;
+      }
+      last_tick = now;
+      last_tick_counting = counting;
+
+      uint32_t rem_ms = (tick.rem_us + 999) / 1000;
+      bool final = running && !send_null && rem_ms <= p->final_window_ms;
+      if (final) {
+        r.final_ticks++;
+        if (plan.copies != p->final_copies)
+          r.final_short++;
+      } else if (plan.copies != p->copies) {
+        r.boosted_outside++;
+      }
+      if (send_null && r.null_aired_us < 0)
+        r.null_aired_us = now;
+
+      if (ticks_left > 0) {
+        int64_t gap = now - last_switch_tick;
+        if (last_switch_tick >= 0 && gap > r.max_switch_gap_us)
+          r.max_switch_gap_us = gap;
+        last_switch_tick = now;
+        if (--ticks_left == 0) {
+          hopped = true;
+          r.hops++;
+          last_switch_tick = -1;
+        }
+      }
+      radio_tx_cadence_sent(&cadence, &tick, &plan);
+      if (hopped)
+        radio_tx_cadence_force(&cadence);
+    }
+
+    int64_t deadline =
+        hopped ? now : radio_tx_cadence_deadline(&cadence, &tick, &plan);
+    CHECK(hopped || deadline > now, "deadline %lld at or before %lld",
+          (long long)deadline, (long long)now);
+    if (!hopped && deadline <= now)
+      deadline = now + 1;
+
+    // The carried value must change no later than the displayed one
+    int64_t visible = timer_manager_next_event_us(&tm);
+    if (running && !send_null && tick.rem_us > 0 && visible >= 0 &&
+        deadline > now + visible)
+      r.late++;
+
+    int64_t wake = deadline;
+    if (control_loop && visible >= 0 && now + visible < wake)
+      wake = now + (visible > 0 ? visible : 1);
+    if (next < count && (int64_t)ev[next].at_ms * MS < wake)
+      wake = (int64_t)ev[next].at_ms * MS;
+    if (wake <= now && !hopped)
+      wake = now + 1;
+    timer_fake_clock_advance_us(&fake, wake - now);
+    now = wake;
+  }
+  return r;
+}
+
+#define REPLAY(policy, events, end_ms, control_loop)                           \
+  replay(policy, events, (int)(sizeof(events) / sizeof(events[0])), end_ms,   \
+         control_loop)
+
+static void check_bound(const Replay *r, const char *name) {
+  CHECK(r->ticks > 0, "%s: nothing aired", name);
+  CHECK(r->max_silence_us <= BOUND_US,
+        "%s: receivers silent for %lld ms (bound %d ms)", name,
+        (long long)(r->max_silence_us / MS), RADIO_RX_STALE_BOUND_MS);
+  CHECK(r->late == 0, "%s: %u deadlines after the value changed", name,
+        r->late);
+}
+
+// -----------------------------------------------------------------------------
+// Scenarios
+// -----------------------------------------------------------------------------
+static const Event paused[] = {{0, EV_RESET, 24}};
+
+// 24 s run out with the final window, zero and the null signal, then a
+// reset; a stop at 14.2 s for 2 s on the way
+static const Event game[] = {
+    {0, EV_START, 0},
+    {9800, EV_STOP, 0},
+    {11800, EV_START, 0},
+    {40000, EV_RESET, 24},
+};
+
+static const Event switch_paused[] = {{5000, EV_SWITCH, 0}};
+static const Event switch_running[] = {
+    {0, EV_START, 0},
+    {5000, EV_SWITCH, 0},
+    {20500, EV_SWITCH, 0}, // inside the tenths window
+};
+
+static void test_paused(void) {
+  RadioTxPolicy p = RADIO_TX_POLICY_DEFAULT;
+  for (int loop = 0; loop < 2; loop++) {
+    Replay r = REPLAY(&p, paused, 60000, loop);
+    check_bound(&r, "paused");
+    // Nothing moves: only the idle keep-alive goes out
+    CHECK(r.max_silence_us == (int64_t)p.idle_keepalive_ms * MS,
+          "paused: longest silence %lld ms, expected the idle keep-alive",
+          (long long)(r.max_silence_us / MS));
+    CHECK(r.ticks == 60000 / p.idle_keepalive_ms + 1, "paused: %u ticks",
+          r.ticks);
+  }
+}
+
+static void test_game(void) {
+  RadioTxPolicy p = RADIO_TX_POLICY_DEFAULT;
+  for (int extended = 0; extended < 2; extended++) {
+    p.extended_frames = extended;
+    for (int loop = 0; loop < 2; loop++) {
+      Replay r = REPLAY(&p, game, 45000, loop);
+      check_bound(&r, "game");
+      CHECK(r.max_running_gap_us <= (int64_t)p.active_keepalive_ms * MS,
+            "game: %lld ms between ticks while counting down",
+            (long long)(r.max_running_gap_us / MS));
+
+      // 3 s to go: every decisecond plus the zero frame, all boosted
+      CHECK(r.final_ticks >= 31, "game: %u ticks in the final window",
+            r.final_ticks);
+      CHECK(r.final_short == 0, "game: %u final ticks without the boost",
+            r.final_short);
+      CHECK(r.boosted_outside == 0, "game: %u boosted ticks outside the "
+                                    "final window",
+            r.boosted_outside);
+
+      // The null signal reaches the displays within the idle keep-alive
+      CHECK(r.null_due_us >= 0 && r.null_aired_us >= r.null_due_us &&
+                r.null_aired_us - r.null_due_us <=
+                    (int64_t)p.idle_keepalive_ms * MS,
+            "game: null due at %lld ms, aired at %lld ms",
+            (long long)(r.null_due_us / MS),
+            (long long)(r.null_aired_us / MS));
+    }
+  }
+}
+
+static void test_switch(void) {
+  RadioTxPolicy p = RADIO_TX_POLICY_DEFAULT;
+  for (int extended = 0; extended < 2; extended++) {
+    p.extended_frames = extended;
+    for (int loop = 0; loop < 2; loop++) {
+      Replay r = REPLAY(&p, switch_paused, 20000, loop);
+      check_bound(&r, "switch paused");
+      CHECK(r.hops == 1, "switch paused: %u hops", r.hops);
+      // Announced even when paused: at the active keep-alive
+      if (extended)
+        CHECK(r.max_switch_gap_us <= (int64_t)p.active_keepalive_ms * MS,
+              "switch paused: announcement ticks %lld ms apart",
+              (long long)(r.max_switch_gap_us / MS));
+
+      r = REPLAY(&p, switch_running, 30000, loop);
+      check_bound(&r, "switch running");
+      CHECK(r.hops == 2, "switch running: %u hops", r.hops);
+      CHECK(r.max_running_gap_us <= (int64_t)p.active_keepalive_ms * MS,
+            "switch running: %lld ms between ticks while counting down",
+            (long long)(r.max_running_gap_us / MS));
+      if (!extended)
+        CHECK(r.hop_silence_us <= (int64_t)p.active_keepalive_ms * MS,
+              "unannounced hop: %lld ms since the last tick",
+              (long long)(r.hop_silence_us / MS));
+    }
+  }
+}
+
+// Any policy radio_tx_start() accepts keeps the bound, including both
+// keep-alives at the bound itself
+static void test_policies(void) {
+  RadioTxPolicy p = RADIO_TX_POLICY_DEFAULT;
+  CHECK(radio_tx_policy_valid(&p), "default policy rejected");
+  p.idle_keepalive_ms = RADIO_RX_STALE_BOUND_MS + 1;
+  CHECK(!radio_tx_policy_valid(&p), "idle keep-alive past the bound accepted");
+  p = RADIO_TX_POLICY_DEFAULT;
+  p.active_keepalive_ms = 0;
+  CHECK(!radio_tx_policy_valid(&p), "zero keep-alive accepted");
+  p = RADIO_TX_POLICY_DEFAULT;
+  p.final_copies = RADIO_TX_BURST_MAX + 1;
+  CHECK(!radio_tx_policy_valid(&p), "final burst past the limit accepted");
+
+  static const uint32_t keepalives[] = {100, 250, 1000,
+                                        RADIO_RX_STALE_BOUND_MS};
+  for (size_t a = 0; a < 4; a++) {
+    for (size_t i = a; i < 4; i++) {
+      p = RADIO_TX_POLICY_DEFAULT;
+      p.active_keepalive_ms = keepalives[a];
+      p.idle_keepalive_ms = keepalives[i];
+      CHECK(radio_tx_policy_valid(&p), "keep-alives %u/%u rejected",
+            keepalives[a], keepalives[i]);
+      for (int extended = 0; extended < 2; extended++) {
+        p.extended_frames = extended;
+        Replay r = REPLAY(&p, paused, 20000, false);
+        check_bound(&r, "custom paused");
+        r = REPLAY(&p, game, 45000, false);
+        check_bound(&r, "custom game");
+        r = REPLAY(&p, switch_running, 30000, false);
+        check_bound(&r, "custom switch");
+      }
+    }
+  }
+}
+
+int main(void) {
+  test_paused();
+  test_game();
+  test_switch();
+  test_policies();
+  return HOST_TEST_RESULT("radio_tx_cadence");
+}
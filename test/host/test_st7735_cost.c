@@ -0,0 +1,193 @@
+// SPI cost per UI operation, counted on the panel model: what each render
+// command puts on the wire in framebuffer mode (what the firmware runs)
+// against direct drawing (every primitive its own window, as before the
+// shadow framebuffer). Prints the table and fails when an operation goes
+// over its budget, or when the driver's own St7735Stats disagree with what
+// the panel actually received
+#include "host_test.h"
+#include "panel_model.h"
+#include "radio_config.h"
+#include "sport_manager.h"
+#include "st7735_lcd.h"
+#include "ui/ui_helpers.h"
+#include "ui/ui_st7735_main.h"
+#include "ui/ui_st7735_menus.h"
+#include "ui_manager.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+HOST_TEST_DEFINE_FAILURES();
+
+#define PIN_CS GPIO_NUM_5
+#define PIN_DC GPIO_NUM_2
+#define PIN_RST GPIO_NUM_4
+#define PIN_MOSI GPIO_NUM_23
+#define PIN_SCK GPIO_NUM_18
+
+// Framebuffer-mode ceilings, a little above what the driver does today. A
+// window set is at most 5 transactions (CASET+4, RASET+4, RAMWR) and a
+// flush streams each merged region as one or two DMA bursts, so a whole
+// screen is one window of 40 KB and a digit update one small band
+typedef struct {
+  const char *name;
+  uint32_t max_transactions;
+  uint32_t max_data_bytes;
+  uint32_t max_pixel_bursts;
+} CostBudget;
+
+#define FULL_SCREEN_BYTES (ST7735_WIDTH * ST7735_HEIGHT * 2)
+#define WINDOW_BYTES 8 // CASET + RASET parameters
+
+static const CostBudget budgets[] = {
+    {"main_screen", 6, FULL_SCREEN_BYTES + WINDOW_BYTES, 2},
+    {"time_update", 6, 2048 + WINDOW_BYTES, 1},
+    {"time_width", 8, 4096 + WINDOW_BYTES, 2},
+    {"tenths_enter", 8, 6144 + WINDOW_BYTES, 2},
+    {"tenths_tick", 6, 2048 + WINDOW_BYTES, 1},
+    {"status", 12, 2048 + 2 * WINDOW_BYTES, 2},
+    {"game_clock", 8, 2560 + WINDOW_BYTES, 2},
+    {"sport_menu", 6, FULL_SCREEN_BYTES + WINDOW_BYTES, 2},
+    {"sport_select", 8, 512, 1},
+    {"variant_menu", 6, FULL_SCREEN_BYTES + WINDOW_BYTES, 2},
+    {"channel_menu", 6, FULL_SCREEN_BYTES + WINDOW_BYTES, 2},
+};
+#define BUDGET_COUNT (sizeof(budgets) / sizeof(budgets[0]))
+
+static UiManager ui;
+static SportManager sm;
+static PanelCounters measured[2][BUDGET_COUNT]; // [framebuffer][op]
+
+static void bring_up(bool framebuffer) {
+  memset(&ui, 0, sizeof(ui));
+  panel_model_reset(PIN_DC);
+  st7735_begin(&ui.st7735, PIN_CS, PIN_DC, PIN_RST, PIN_MOSI, PIN_SCK);
+  if (framebuffer)
+    st7735_framebuffer_enable(&ui.st7735);
+  st7735_sprite_cache_prepare(&ui.st7735, 4, ST7735_WHITE, ST7735_BLACK);
+  st7735_sprite_cache_prepare(&ui.st7735, 2, ST7735_WHITE, ST7735_BLACK);
+  ui_draw_st7735_blank_screen(&ui);
+  st7735_flush(&ui.st7735);
+  st7735_wait_idle(&ui.st7735);
+}
+
+static void op_begin(void) {
+  st7735_wait_idle(&ui.st7735);
+  st7735_stats_reset(&ui.st7735);
+  panel_model_counters_reset();
+}
+
+static void op_end(bool framebuffer, int op) {
+  st7735_flush(&ui.st7735);
+  st7735_wait_idle(&ui.st7735);
+
+  PanelCounters c = panel_model_counters();
+  const St7735Stats *st = &ui.st7735.stats;
+  const char *name = budgets[op].name;
+  CHECK(c.errors == 0, "%s: panel protocol error: %s", name,
+        panel_model_last_error());
+  CHECK(st->transactions == c.transactions && st->commands == c.commands &&
+            st->data_bytes == c.data_bytes && st->windows == c.windows,
+        "%s: St7735Stats (%lu trans, %lu cmd, %lu data, %lu win) disagree "
+        "with the panel (%lu, %lu, %lu, %lu)",
+        name, (unsigned long)st->transactions, (unsigned long)st->commands,
+        (unsigned long)st->data_bytes, (unsigned long)st->windows,
+        (unsigned long)c.transactions, (unsigned long)c.commands,
+        (unsigned long)c.data_bytes, (unsigned long)c.windows);
+  measured[framebuffer][op] = c;
+}
+
+// Same sequence as the on-device render benchmark (ui_run_benchmark)
+static void run_ops(bool framebuffer) {
+  sport_config_t sport = sport_manager_get_current_sport(&sm);
+  uint16_t sec = sport.play_clock_seconds;
+  size_t group_count;
+  const sport_group_t *groups = sport_manager_get_groups(&group_count);
+  static const uint8_t channels[] = {76, 82, 78, 74, 49, 24};
+  uint16_t scores[6] = {0, RADIO_SURVEY_SAMPLES / 2, 0, 0, 0, 0};
+  int op = 0;
+
+  bring_up(framebuffer);
+
+  op_begin();
+  ui_draw_st7735_main(&ui, &sport, sec, &sm);
+  op_end(framebuffer, op++);
+
+  op_begin();
+  ui_st7735_update_time(&ui, &sport, sec - 1, &sm);
+  op_end(framebuffer, op++);
+
+  op_begin();
+  ui_st7735_update_time(&ui, &sport, 9, &sm);
+  op_end(framebuffer, op++);
+
+  op_begin();
+  ui_st7735_update_time_tenths(&ui, &sport, 49, &sm);
+  op_end(framebuffer, op++);
+
+  op_begin();
+  ui_st7735_update_time_tenths(&ui, &sport, 48, &sm);
+  op_end(framebuffer, op++);
+
+  op_begin();
+  ui_st7735_draw_status(&ui, true, true, 100);
+  op_end(framebuffer, op++);
+
+  op_begin();
+  ui_st7735_update_game_clock(&ui, "10:00");
+  op_end(framebuffer, op++);
+
+  op_begin();
+  ui_draw_st7735_sport_menu(&ui, groups, group_count, 0);
+  op_end(framebuffer, op++);
+
+  op_begin();
+  ui_st7735_update_sport_menu_selection(&ui, groups, group_count, 1);
+  op_end(framebuffer, op++);
+
+  op_begin();
+  ui_draw_st7735_variant_menu(&ui, sport_manager_get_group(2), 0);
+  op_end(framebuffer, op++);
+
+  op_begin();
+  ui_draw_st7735_channel_menu(&ui, channels, scores, 6, 0, 0);
+  op_end(framebuffer, op++);
+
+  free(ui.st7735.fb);
+  for (int i = 0; i < ST7735_SPRITE_SLOTS; i++)
+    free(ui.st7735.sprites[i].pixels);
+}
+
+int main(void) {
+  sport_manager_init(&sm);
+  run_ops(false);
+  run_ops(true);
+
+  printf("%-14s | %23s | %23s\n", "", "direct", "framebuffer");
+  printf("%-14s | %6s %6s %4s %5s | %6s %6s %4s %5s\n", "operation", "trans",
+         "data", "win", "burst", "trans", "data", "win", "burst");
+  for (size_t i = 0; i < BUDGET_COUNT; i++) {
+    const PanelCounters *d = &measured[0][i];
+    const PanelCounters *f = &measured[1][i];
+    printf("%-14s | %6lu %6lu %4lu %5lu | %6lu %6lu %4lu %5lu\n",
+           budgets[i].name, (unsigned long)d->transactions,
+           (unsigned long)d->data_bytes, (unsigned long)d->windows,
+           (unsigned long)d->pixel_bursts, (unsigned long)f->transactions,
+           (unsigned long)f->data_bytes, (unsigned long)f->windows,
+           (unsigned long)f->pixel_bursts);
+
+    const CostBudget *b = &budgets[i];
+    CHECK(f->transactions <= b->max_transactions,
+          "%s: %lu transactions, budget %lu", b->name,
+          (unsigned long)f->transactions, (unsigned long)b->max_transactions);
+    CHECK(f->data_bytes <= b->max_data_bytes, "%s: %lu data bytes, budget %lu",
+          b->name, (unsigned long)f->data_bytes,
+          (unsigned long)b->max_data_bytes);
+    CHECK(f->pixel_bursts <= b->max_pixel_bursts,
+          "%s: %lu pixel bursts, budget %lu", b->name,
+          (unsigned long)f->pixel_bursts, (unsigned long)b->max_pixel_bursts);
+  }
+
+  return HOST_TEST_RESULT("st7735_cost");
+}
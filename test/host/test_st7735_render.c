@@ -0,0 +1,221 @@
+// Renders every UI screen through the real ST7735 driver and UI modules into
+// the panel model, then compares what reached the panel with the golden
+// snapshots in golden/. Each screen is drawn in the three driver
+// configurations the firmware can end up in (framebuffer, direct with
+// sprites, direct without), and partial updates must leave the panel
+// exactly as a full redraw of the same state would
+//
+//   test_st7735_render <golden dir> <output dir> [--update]
+//
+// Snapshots of the current run go to the output dir; --update rewrites the
+// goldens from it after an intended change to the rendering
+#include "host_test.h"
+#include "panel_model.h"
+#include "radio_config.h"
+#include "sport_manager.h"
+#include "st7735_lcd.h"
+#include "ui/ui_helpers.h"
+#include "ui/ui_st7735_main.h"
+#include "ui/ui_st7735_menus.h"
+#include "ui_manager.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+HOST_TEST_DEFINE_FAILURES();
+
+#define PIN_CS GPIO_NUM_5
+#define PIN_DC GPIO_NUM_2
+#define PIN_RST GPIO_NUM_4
+#define PIN_MOSI GPIO_NUM_23
+#define PIN_SCK GPIO_NUM_18
+
+typedef enum {
+  MODE_FRAMEBUFFER = 0, // what ui_manager_init_st7735() sets up
+  MODE_DIRECT_SPRITES,  // framebuffer allocation failed
+  MODE_DIRECT_RASTER,   // sprite allocation failed as well
+  MODE_COUNT
+} RenderMode;
+
+static const char *const mode_names[MODE_COUNT] = {"framebuffer",
+                                                   "direct+sprites", "direct"};
+
+static const char *golden_dir;
+static const char *out_dir;
+static bool update;
+
+static UiManager ui;
+static SportManager sm;
+static RenderMode mode;
+
+// Same bring-up as ui_manager_init_st7735(), minus the render task
+static void render_begin(RenderMode m) {
+  mode = m;
+  memset(&ui, 0, sizeof(ui));
+  panel_model_reset(PIN_DC);
+  st7735_begin(&ui.st7735, PIN_CS, PIN_DC, PIN_RST, PIN_MOSI, PIN_SCK);
+  if (m == MODE_FRAMEBUFFER)
+    st7735_framebuffer_enable(&ui.st7735);
+  if (m != MODE_DIRECT_RASTER) {
+    st7735_sprite_cache_prepare(&ui.st7735, 4, ST7735_WHITE, ST7735_BLACK);
+    st7735_sprite_cache_prepare(&ui.st7735, 2, ST7735_WHITE, ST7735_BLACK);
+  }
+  ui_draw_st7735_blank_screen(&ui);
+  st7735_flush(&ui.st7735);
+  st7735_wait_idle(&ui.st7735);
+  panel_model_counters_reset();
+}
+
+// What the render task does after each command, then the panel is stable
+static void render_settle(void) {
+  st7735_flush(&ui.st7735);
+  st7735_wait_idle(&ui.st7735);
+
+  PanelCounters c = panel_model_counters();
+  CHECK(c.errors == 0, "%s: panel protocol error: %s", mode_names[mode],
+        panel_model_last_error());
+}
+
+static void render_free(void) {
+  free(ui.st7735.fb);
+  for (int i = 0; i < ST7735_SPRITE_SLOTS; i++)
+    free(ui.st7735.sprites[i].pixels);
+}
+
+// -----------------------------------------------------------------------------
+// Golden snapshots
+// -----------------------------------------------------------------------------
+static void check_golden(const char *name) {
+  char out[512], golden[512];
+  snprintf(out, sizeof(out), "%s/%s-%s.ppm", out_dir, name,
+           mode == MODE_FRAMEBUFFER ? "fb" : "direct");
+  snprintf(golden, sizeof(golden), "%s/%s.ppm", golden_dir, name);
+
+  CHECK(panel_model_write_ppm(out), "cannot write %s", out);
+  if (update && mode == MODE_FRAMEBUFFER) {
+    CHECK(panel_model_write_ppm(golden), "cannot write %s", golden);
+    return;
+  }
+
+  int diff = panel_model_compare_ppm(golden);
+  CHECK(diff == 0, "%s (%s): %d pixels differ from %s (see %s)", name,
+        mode_names[mode], diff, golden, out);
+}
+
+// Full redraw of a state, for comparing an incrementally updated panel
+static uint16_t reference[ST7735_HEIGHT][ST7735_WIDTH];
+
+static void reference_capture(void) {
+  for (int y = 0; y < ST7735_HEIGHT; y++)
+    for (int x = 0; x < ST7735_WIDTH; x++)
+      reference[y][x] = panel_model_pixel(x, y);
+}
+
+static void check_reference(const char *what) {
+  int diff = 0;
+  for (int y = 0; y < ST7735_HEIGHT; y++)
+    for (int x = 0; x < ST7735_WIDTH; x++)
+      diff += panel_model_pixel(x, y) != reference[y][x];
+  CHECK(diff == 0, "%s (%s): %d pixels differ from a full redraw", what,
+        mode_names[mode], diff);
+}
+
+// -----------------------------------------------------------------------------
+// Screens
+// -----------------------------------------------------------------------------
+static const uint8_t channels[] = {76, 82, 78, 74, 49, 24};
+#define CHANNEL_COUNT (sizeof(channels) / sizeof(channels[0]))
+
+static void render_screens(RenderMode m) {
+  sport_config_t sport = sport_manager_get_current_sport(&sm);
+  size_t group_count;
+  const sport_group_t *groups = sport_manager_get_groups(&group_count);
+
+  // Main screen, with the status row and a game clock line
+  render_begin(m);
+  ui_draw_st7735_main(&ui, &sport, 24, &sm);
+  ui_st7735_draw_status(&ui, true, true, 100);
+  ui_st7735_update_game_clock(&ui, "10:00");
+  render_settle();
+  check_golden("main");
+
+  // Countdown into the tenths window: per-second then per-decisecond
+  // differential updates
+  ui_st7735_update_time(&ui, &sport, 23, &sm);
+  ui_st7735_update_time(&ui, &sport, 9, &sm);
+  ui_st7735_update_time_tenths(&ui, &sport, 49, &sm);
+  ui_st7735_update_time_tenths(&ui, &sport, 48, &sm);
+  ui_st7735_draw_status(&ui, false, false, 50);
+  ui_st7735_update_game_clock(&ui, "59.9");
+  render_settle();
+  check_golden("main_tenths");
+  render_free();
+
+  // Differential whole-second updates end where a full redraw would
+  render_begin(m);
+  ui_draw_st7735_main(&ui, &sport, 9, &sm);
+  render_settle();
+  reference_capture();
+  render_free();
+
+  render_begin(m);
+  ui_draw_st7735_main(&ui, &sport, 24, &sm);
+  ui_st7735_update_time(&ui, &sport, 23, &sm);
+  ui_st7735_update_time(&ui, &sport, 10, &sm);
+  ui_st7735_update_time(&ui, &sport, 9, &sm);
+  render_settle();
+  check_reference("time updates 24 -> 9");
+  render_free();
+
+  // Sport menu, then a selection move against a redraw at the new row
+  render_begin(m);
+  ui_draw_st7735_sport_menu(&ui, groups, group_count, 1);
+  render_settle();
+  reference_capture();
+  check_golden("sport_menu");
+  render_free();
+
+  render_begin(m);
+  ui_draw_st7735_sport_menu(&ui, groups, group_count, 0);
+  ui_st7735_update_sport_menu_selection(&ui, groups, group_count, 1);
+  render_settle();
+  check_reference("sport menu selection 0 -> 1");
+  render_free();
+
+  render_begin(m);
+  ui_draw_st7735_variant_menu(&ui, sport_manager_get_group(2), 0);
+  render_settle();
+  check_golden("variant_menu");
+  render_free();
+
+  // Occupancy bars at 0, 1/4, 1/2 and full scale
+  uint16_t scores[CHANNEL_COUNT] = {
+      0, RADIO_SURVEY_SAMPLES / 4, RADIO_SURVEY_SAMPLES / 2,
+      RADIO_SURVEY_SAMPLES, 0, RADIO_SURVEY_SAMPLES / 4};
+  render_begin(m);
+  ui_draw_st7735_channel_menu(&ui, channels, scores, CHANNEL_COUNT, 2, 0);
+  render_settle();
+  check_golden("channel_menu");
+  render_free();
+}
+
+int main(int argc, char **argv) {
+  if (argc < 3) {
+    fprintf(stderr, "usage: %s <golden dir> <output dir> [--update]\n",
+            argv[0]);
+    return 2;
+  }
+  golden_dir = argv[1];
+  out_dir = argv[2];
+  update = argc > 3 && strcmp(argv[3], "--update") == 0;
+  mkdir(out_dir, 0755);
+
+  sport_manager_init(&sm);
+
+  for (int m = 0; m < MODE_COUNT; m++)
+    render_screens((RenderMode)m);
+
+  return HOST_TEST_RESULT("st7735_render");
+}
@@ -0,0 +1,360 @@
+// TimerManager on a TimerFakeClock: the play clock's rounding and its exact
+// zero instant, stop/start keeping the fraction of a second, the null
+// signal delay, the next-event deadline, the court timers' link rules and
+// the mm:ss format
+#include "host_test.h"
+#include "timer_manager.h"
+#include <stdint.h>
+#include <string.h>
+
+HOST_TEST_DEFINE_FAILURES();
+
+#define MS 1000LL
+#define S 1000000LL
+#define START_US 123456789LL // arbitrary origin, not a round number
+
+static TimerFakeClock fake;
+
+static void init(TimerManager *m, uint16_t seconds) {
+  timer_manager_init(m, seconds, timer_fake_clock_init(&fake, START_US));
+}
+
+static void advance(TimerManager *m, int64_t us) {
+  timer_fake_clock_advance_us(&fake, us);
+  timer_manager_update(m);
+}
+
+static void check_text(const TimerManager *m, uint8_t id, const char *want,
+                       int line) {
+  char buf[16];
+  timer_manager_timer_text(m, id, buf, sizeof(buf));
+  CHECK(strcmp(buf, want) == 0, "line %d: timer %u shows \"%s\", expected "
+                                "\"%s\" (%lld us left)",
+        line, id, buf, want,
+        (long long)timer_manager_timer_remaining_us(m, id));
+}
+
+#define CHECK_TEXT(m, id, want) check_text(m, id, want, __LINE__)
+
+// -----------------------------------------------------------------------------
+// Play clock
+// -----------------------------------------------------------------------------
+static void test_play_rounding(void) {
+  TimerManager m;
+  init(&m, 24);
+  timer_manager_start(&m);
+
+  // Whole seconds are a ceiling: "24" until 23.0 is crossed
+  advance(&m, 1);
+  CHECK(timer_manager_get_seconds(&m) == 24, "1 us in: %u s",
+        timer_manager_get_seconds(&m));
+  advance(&m, S - 1);
+  CHECK(timer_manager_get_seconds(&m) == 23, "1 s in: %u s",
+        timer_manager_get_seconds(&m));
+
+  // Tenths truncate: 4.95 s reads 4.9
+  advance(&m, 23 * S - 4950 * MS);
+  CHECK(timer_manager_get_remaining_us(&m) == 4950 * MS, "%lld us left",
+        (long long)timer_manager_get_remaining_us(&m));
+  CHECK(timer_manager_get_deciseconds(&m) == 49, "4.95 s: %u ds",
+        timer_manager_get_deciseconds(&m));
+  CHECK_TEXT(&m, TIMER_PLAY, "4.9");
+
+  // Remaining ms rounds up: 0 only once really expired
+  advance(&m, 4950 * MS - 1);
+  CHECK(timer_manager_get_remaining_ms(&m) == 1 &&
+            timer_manager_get_deciseconds(&m) == 0,
+        "1 us left: %u ms %u ds", timer_manager_get_remaining_ms(&m),
+        timer_manager_get_deciseconds(&m));
+  CHECK_TEXT(&m, TIMER_PLAY, "0.0");
+  advance(&m, 1);
+  CHECK(timer_manager_get_remaining_ms(&m) == 0, "expired: %u ms",
+        timer_manager_get_remaining_ms(&m));
+  CHECK_TEXT(&m, TIMER_PLAY, "0");
+}
+
+static void test_stop_keeps_fraction(void) {
+  TimerManager m;
+  init(&m, 24);
+  timer_manager_start(&m);
+  timer_fake_clock_advance_us(&fake, 20 * S + 600 * MS + 7);
+  timer_manager_stop(&m); // no update in between: stop accrues it
+  CHECK(timer_manager_get_remaining_us(&m) == 3 * S + 400 * MS - 7,
+        "stopped at %lld us", (long long)timer_manager_get_remaining_us(&m));
+  CHECK(timer_manager_get_sample_us(&m) == fake.now_us,
+        "sample at %lld, clock at %lld",
+        (long long)timer_manager_get_sample_us(&m), (long long)fake.now_us);
+
+  // Time spent stopped is never charged
+  advance(&m, 10 * S);
+  timer_manager_start(&m);
+  advance(&m, 400 * MS - 7);
+  CHECK(timer_manager_get_remaining_us(&m) == 3 * S,
+        "resumed, %lld us left", (long long)timer_manager_get_remaining_us(&m));
+
+  // Adjust only while stopped, clamped to the 2-digit range
+  timer_manager_adjust_ms(&m, 1000);
+  CHECK(timer_manager_get_remaining_us(&m) == 3 * S, "adjusted while running");
+  timer_manager_stop(&m);
+  timer_manager_adjust_ms(&m, 200000);
+  CHECK(timer_manager_get_remaining_us(&m) == TIMER_MAX_SECONDS * S,
+        "adjust clamped to %lld us",
+        (long long)timer_manager_get_remaining_us(&m));
+  timer_manager_adjust_ms(&m, -200000);
+  CHECK(timer_manager_get_remaining_us(&m) == 0, "adjust below zero: %lld us",
+        (long long)timer_manager_get_remaining_us(&m));
+}
+
+static void test_null_signal(void) {
+  TimerManager m;
+  init(&m, 2);
+  timer_manager_start(&m);
+
+  // Sampled late: the delay still runs from the real zero instant
+  advance(&m, 2 * S + 700 * MS);
+  CHECK(!timer_manager_should_send_null(&m), "null right after expiry");
+  CHECK(timer_manager_next_event_us(&m) == TIMER_NULL_SIGNAL_DELAY_MS * MS -
+                                               700 * MS,
+        "null due in %lld us", (long long)timer_manager_next_event_us(&m));
+  timer_fake_clock_advance_us(&fake, TIMER_NULL_SIGNAL_DELAY_MS * MS -
+                                         700 * MS - 1);
+  CHECK(!timer_manager_should_send_null(&m), "null 1 us early");
+  timer_fake_clock_advance_us(&fake, 1);
+  CHECK(timer_manager_should_send_null(&m), "no null after the delay");
+  CHECK(timer_manager_next_event_us(&m) == -1, "event pending at rest: %lld",
+        (long long)timer_manager_next_event_us(&m));
+
+  // A reset clears it
+  timer_manager_reset(&m, 24);
+  CHECK(!timer_manager_should_send_null(&m), "null after a reset");
+}
+
+static void test_next_event(void) {
+  TimerManager m;
+  init(&m, 24);
+  CHECK(timer_manager_next_event_us(&m) == -1, "stopped clock has an event");
+
+  timer_manager_start(&m);
+  advance(&m, 300 * MS);
+  CHECK(timer_manager_next_event_us(&m) == 700 * MS, "24 -> 23 in %lld us",
+        (long long)timer_manager_next_event_us(&m));
+
+  // 5.3 s shows "6": next "5" at 5.0, then tenths from 4.999 on
+  advance(&m, 18 * S + 400 * MS);
+  CHECK(timer_manager_get_remaining_us(&m) == 5300 * MS, "%lld us left",
+        (long long)timer_manager_get_remaining_us(&m));
+  CHECK(timer_manager_next_event_us(&m) == 300 * MS, "6 -> 5 in %lld us",
+        (long long)timer_manager_next_event_us(&m));
+  advance(&m, 300 * MS);
+  CHECK(timer_manager_next_event_us(&m) == 1 * MS, "5 -> 4.9 in %lld us",
+        (long long)timer_manager_next_event_us(&m));
+
+  // Inside the window: every decisecond (4.969 -> 4.8 below 4.899)
+  advance(&m, 31 * MS);
+  CHECK(timer_manager_next_event_us(&m) == 70 * MS, "next tenth in %lld us",
+        (long long)timer_manager_next_event_us(&m));
+}
+
+// -----------------------------------------------------------------------------
+// Court timers: mm:ss
+// -----------------------------------------------------------------------------
+static void test_mmss_text(void) {
+  TimerManager m;
+  init(&m, 24);
+  uint8_t game = timer_manager_add(&m, TIMER_FORMAT_MMSS, 600, 1);
+  CHECK(game == 1, "first court timer got id %u", game);
+  CHECK(timer_manager_timer_format(&m, game) == TIMER_FORMAT_MMSS &&
+            timer_manager_timer_radio_channel(&m, game) == 1,
+        "format %d channel %u", timer_manager_timer_format(&m, game),
+        timer_manager_timer_radio_channel(&m, game));
+
+  static const struct {
+    int64_t remaining_us;
+    const char *text;
+  } cases[] = {
+      {600 * S, "10:00"},
+      {599 * S + 1, "10:00"}, // ceiling, as the play clock
+      {599 * S, "9:59"},
+      {61 * S, "1:01"},
+      {60 * S + 1, "1:01"},
+      {60 * S, "1:00"}, // tenths only below a minute
+      {60 * S - 1 * MS, "59.9"},
+      {10 * S + 50 * MS, "10.0"},
+      {100 * MS, "0.1"},
+      {1, "0.0"},
+      {0, "0:00"},
+  };
+  for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+    timer_manager_timer_reset(&m, game, 600);
+    timer_manager_timer_start(&m, game);
+    advance(&m, 600 * S - cases[i].remaining_us);
+    timer_manager_timer_stop(&m, game);
+    CHECK_TEXT(&m, game, cases[i].text);
+  }
+
+  // Clamped to 99:59; a seconds-format court timer to 99
+  timer_manager_timer_reset(&m, game, 7000);
+  CHECK_TEXT(&m, game, "99:59");
+  uint8_t shot = timer_manager_add(&m, TIMER_FORMAT_SECONDS, 300, 2);
+  CHECK_TEXT(&m, shot, "99");
+  CHECK(timer_manager_add(&m, TIMER_FORMAT_MMSS, 60, 3) == 3,
+        "fourth timer rejected");
+  CHECK(timer_manager_add(&m, TIMER_FORMAT_MMSS, 60, 3) == TIMER_NONE,
+        "more than TIMER_MAX_TIMERS accepted");
+}
+
+static void test_mmss_next_event(void) {
+  TimerManager m;
+  init(&m, 24);
+  uint8_t game = timer_manager_add(&m, TIMER_FORMAT_MMSS, 61, 1);
+  timer_manager_timer_start(&m, game);
+  advance(&m, 200 * MS);
+  CHECK(timer_manager_next_event_us(&m) == 800 * MS, "1:01 -> 1:00 in %lld us",
+        (long long)timer_manager_next_event_us(&m));
+  // From 1:00 straight to 59.9, not to 0:59
+  advance(&m, 800 * MS);
+  CHECK(timer_manager_next_event_us(&m) == 1 * MS, "1:00 -> 59.9 in %lld us",
+        (long long)timer_manager_next_event_us(&m));
+}
+
+// -----------------------------------------------------------------------------
+// Court timers: link rules
+// -----------------------------------------------------------------------------
+static void test_link_cap(void) {
+  // Shot clock capped by the game clock: 24 with 10 s of game left shows 10
+  TimerManager m;
+  init(&m, 24);
+  uint8_t game = timer_manager_add(&m, TIMER_FORMAT_MMSS, 10, 1);
+  CHECK(!timer_manager_link(&m, TIMER_PLAY, TIMER_PLAY, TIMER_LINK_CAP),
+        "linked a timer to itself");
+  CHECK(!timer_manager_link(&m, TIMER_PLAY, 3, TIMER_LINK_CAP),
+        "linked to a timer that does not exist");
+  CHECK(timer_manager_link(&m, TIMER_PLAY, game, TIMER_LINK_CAP),
+        "cap link rejected");
+  CHECK(timer_manager_get_remaining_us(&m) == 10 * S,
+        "cap not applied at link time: %lld us",
+        (long long)timer_manager_get_remaining_us(&m));
+
+  // A reset above the leader is capped too
+  timer_manager_reset(&m, 24);
+  CHECK(timer_manager_get_seconds(&m) == 10, "reset past the cap: %u s",
+        timer_manager_get_seconds(&m));
+
+  // Only the leader runs: the stopped follower is dragged down and expires
+  // at the leader's zero instant
+  timer_manager_timer_start(&m, game);
+  advance(&m, 4 * S);
+  CHECK(timer_manager_get_remaining_us(&m) == 6 * S,
+        "follower at %lld us, leader at %lld us",
+        (long long)timer_manager_get_remaining_us(&m),
+        (long long)timer_manager_timer_remaining_us(&m, game));
+  advance(&m, 6 * S + 500 * MS);
+  CHECK(timer_manager_get_remaining_us(&m) == 0 &&
+            m.zero_reached_us[TIMER_PLAY] == m.zero_reached_us[game] &&
+            m.zero_reached_us[game] == START_US + 10 * S,
+        "zero at %lld, leader at %lld",
+        (long long)m.zero_reached_us[TIMER_PLAY],
+        (long long)m.zero_reached_us[game]);
+  CHECK(!timer_manager_should_send_null(&m), "null right after expiry");
+  timer_fake_clock_advance_us(&fake,
+                              TIMER_NULL_SIGNAL_DELAY_MS * MS - 500 * MS);
+  CHECK(timer_manager_should_send_null(&m),
+        "null not timed from the leader's zero");
+
+  // A leader set to zero while stopped never expired: the follower's zero
+  // is the instant the cap took it there
+  timer_manager_timer_stop(&m, game);
+  timer_manager_timer_reset(&m, game, 0);
+  advance(&m, 1 * S);
+  int64_t capped_at = fake.now_us;
+  timer_manager_reset(&m, 24);
+  advance(&m, 1 * S);
+  CHECK(timer_manager_get_remaining_us(&m) == 0 &&
+            m.zero_reached_us[TIMER_PLAY] == capped_at,
+        "capped to zero at %lld, expected %lld",
+        (long long)m.zero_reached_us[TIMER_PLAY], (long long)capped_at);
+}
+
+static void test_link_stop_start(void) {
+  TimerManager m;
+  init(&m, 24);
+  uint8_t game = timer_manager_add(&m, TIMER_FORMAT_MMSS, 600, 1);
+
+  // Linking to a stopped leader stops the follower at once
+  timer_manager_start(&m);
+  CHECK(timer_manager_link(&m, TIMER_PLAY, game,
+                           TIMER_LINK_STOP | TIMER_LINK_START),
+        "stop/start link rejected");
+  CHECK(!timer_manager_is_running(&m), "follower runs with a stopped leader");
+
+  // ...and it can't be started on its own while the leader is stopped
+  timer_manager_start(&m);
+  CHECK(!timer_manager_is_running(&m), "follower started without the leader");
+
+  // Started with the leader, stopped with it, charged the same time
+  timer_manager_timer_start(&m, game);
+  CHECK(timer_manager_is_running(&m), "follower not started with the leader");
+  advance(&m, 3 * S + 250 * MS);
+  timer_manager_timer_stop(&m, game);
+  CHECK(!timer_manager_is_running(&m), "follower not stopped with the leader");
+  CHECK(timer_manager_get_remaining_us(&m) == 20 * S + 750 * MS &&
+            timer_manager_timer_remaining_us(&m, game) ==
+                596 * S + 750 * MS,
+        "follower %lld us, leader %lld us",
+        (long long)timer_manager_get_remaining_us(&m),
+        (long long)timer_manager_timer_remaining_us(&m, game));
+
+  // A follower stopped on its own keeps its time while the leader runs
+  timer_manager_timer_start(&m, game);
+  timer_manager_stop(&m);
+  advance(&m, 5 * S);
+  CHECK(timer_manager_get_remaining_us(&m) == 20 * S + 750 * MS,
+        "stopped follower charged: %lld us",
+        (long long)timer_manager_get_remaining_us(&m));
+
+  // A follower at zero is not restarted with the leader
+  timer_manager_timer_stop(&m, game);
+  timer_manager_reset(&m, 0);
+  timer_manager_timer_start(&m, game);
+  CHECK(!timer_manager_is_running(&m), "expired follower restarted");
+
+  // Dropping the court timers drops the link: the play clock is free again
+  timer_manager_drop_court_timers(&m);
+  CHECK(m.count == 1 && m.link_leader[TIMER_PLAY] == TIMER_NONE,
+        "%u timers, play clock leader %u", m.count,
+        m.link_leader[TIMER_PLAY]);
+  timer_manager_reset(&m, 24);
+  timer_manager_start(&m);
+  CHECK(timer_manager_is_running(&m), "play clock still bound after the drop");
+}
+
+static void test_one_sample_instant(void) {
+  // Every change brings all timers to the same instant: starting one never
+  // hands another the time since the last update
+  TimerManager m;
+  init(&m, 24);
+  uint8_t game = timer_manager_add(&m, TIMER_FORMAT_MMSS, 600, 1);
+  timer_manager_start(&m);
+  timer_fake_clock_advance_us(&fake, 2 * S);
+  timer_manager_timer_start(&m, game);
+  timer_fake_clock_advance_us(&fake, 1 * S);
+  timer_manager_update(&m);
+  CHECK(timer_manager_get_remaining_us(&m) == 21 * S &&
+            timer_manager_timer_remaining_us(&m, game) == 599 * S,
+        "play %lld us, game %lld us",
+        (long long)timer_manager_get_remaining_us(&m),
+        (long long)timer_manager_timer_remaining_us(&m, game));
+}
+
+int main(void) {
+  test_play_rounding();
+  test_stop_keeps_fraction();
+  test_null_signal();
+  test_next_event();
+  test_mmss_text();
+  test_mmss_next_event();
+  test_link_cap();
+  test_link_stop_start();
+  test_one_sample_instant();
+  return HOST_TEST_RESULT("timer_manager");
+}